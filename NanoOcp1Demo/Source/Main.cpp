@@ -20,6 +20,45 @@
 
 #include "MainComponent.h"
 
+#include "../../Source/Ocp1CaptureFile.h"
+#include "../../Source/Ocp1DecodeBenchmark.h"
+#include "../../Source/Ocp1DecodeFuzzer.h"
+#include "../../Source/Ocp1DS100ObjectDefinitions.h"
+
+#include <iostream>
+
+
+/**
+ * Set to 1 in the project's preprocessor definitions to have the decode benchmark report
+ * heap allocations per message. Replaces the global operator new, so it is off by default.
+ */
+#ifndef NANOOCP1_COUNT_ALLOCATIONS
+    #define NANOOCP1_COUNT_ALLOCATIONS 0
+#endif
+
+#if NANOOCP1_COUNT_ALLOCATIONS
+static std::atomic<std::uint64_t> s_allocationCount{ 0 };
+
+void* operator new(std::size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+
 namespace NanoOcp1Demo
 {
 
@@ -37,7 +76,42 @@ public:
     //==============================================================================
     void initialise (const String& commandLine) override
     {
-        ignoreUnused(commandLine);
+        // Headless: NanoOcp1Demo --decode-benchmark <capture file> [iterations]
+        //           NanoOcp1Demo --byteorder-benchmark [iterations]
+        //           NanoOcp1Demo --decode-fuzz [iterations] [capture file]
+        auto args = StringArray::fromTokens(commandLine, true);
+        auto byteOrderArgIndex = args.indexOf("--byteorder-benchmark");
+        if (byteOrderArgIndex >= 0)
+        {
+            auto iterations = args[byteOrderArgIndex + 1].getIntValue();
+            std::cout << NanoOcp1::Ocp1DecodeBenchmark::RunByteOrderBenchmark(iterations > 0 ? iterations : 1000) << std::endl;
+            quit();
+            return;
+        }
+
+        auto fuzzArgIndex = args.indexOf("--decode-fuzz");
+        if (fuzzArgIndex >= 0)
+        {
+            auto iterations = args[fuzzArgIndex + 1].getIntValue();
+            auto captureFile = args[fuzzArgIndex + 2].isNotEmpty()
+                ? File::getCurrentWorkingDirectory().getChildFile(args[fuzzArgIndex + 2].unquoted())
+                : File();
+
+            setApplicationReturnValue(runDecodeFuzz(iterations > 0 ? iterations : 1000000, captureFile));
+            quit();
+            return;
+        }
+
+        auto benchmarkArgIndex = args.indexOf("--decode-benchmark");
+        if (benchmarkArgIndex >= 0)
+        {
+            auto captureFile = File::getCurrentWorkingDirectory().getChildFile(args[benchmarkArgIndex + 1].unquoted());
+            auto iterations = jmax(1, args[benchmarkArgIndex + 2].getIntValue());
+
+            setApplicationReturnValue(runDecodeBenchmark(captureFile, iterations));
+            quit();
+            return;
+        }
 
         mainWindow.reset (new MainWindow (getApplicationName()));
     }
@@ -111,6 +185,78 @@ public:
     };
 
 private:
+    //==============================================================================
+    /*
+        Decodes the received messages of the given capture file, see Ocp1CaptureFile.h,
+        and prints the throughput. Values are decoded with the data types of the
+        objects this demo and a DS100 with 64 sound objects use.
+    */
+    int runDecodeBenchmark(const File& captureFile, int iterations)
+    {
+        auto ok = false;
+        auto records = NanoOcp1::Ocp1CaptureReader::ReadAll(captureFile, &ok);
+        if (!ok)
+        {
+            std::cerr << "Not a valid capture file: " << captureFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::vector<std::unique_ptr<NanoOcp1::Ocp1CommandDefinition>> defs;
+        defs.push_back(std::make_unique<NanoOcp1::AmpDxDy::dbOcaObjectDef_Settings_PwrOn>());
+        defs.push_back(std::make_unique<NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel>(1));
+        defs.push_back(std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Fixed_GUID>());
+        for (std::uint32_t channel = 1; channel <= 64; channel++)
+        {
+            defs.push_back(std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Positioning_Source_Position>(channel));
+            defs.push_back(std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Positioning_Source_Enable>(channel));
+            defs.push_back(std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Positioning_Speaker_Group>(channel));
+        }
+
+        std::vector<const NanoOcp1::Ocp1CommandDefinition*> defPtrs;
+        for (const auto& def : defs)
+            defPtrs.push_back(def.get());
+
+        NanoOcp1::Ocp1DecodeBenchmark benchmark(records, defPtrs);
+       #if NANOOCP1_COUNT_ALLOCATIONS
+        benchmark.setAllocationCounter([] { return s_allocationCount.load(std::memory_order_relaxed); });
+       #endif
+
+        auto result = benchmark.run(iterations);
+        std::cout << captureFile.getFileName() << ", " << benchmark.getMessageCount() << " messages x " << iterations << " iterations" << std::endl
+            << result.toString() << std::endl;
+
+        return 0;
+    }
+
+    /*
+        Feeds mutations of well-formed messages, and of the messages of the given capture file
+        if any, to the decoder and prints how they were rejected. Fails if the decoder
+        misbehaved on any of them.
+    */
+    int runDecodeFuzz(int iterations, const File& captureFile)
+    {
+        NanoOcp1::Ocp1DecodeFuzzer fuzzer;
+
+        if (captureFile != File())
+        {
+            auto ok = false;
+            auto records = NanoOcp1::Ocp1CaptureReader::ReadAll(captureFile, &ok);
+            if (!ok)
+            {
+                std::cerr << "Not a valid capture file: " << captureFile.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            fuzzer.addToCorpus(records);
+        }
+
+        auto result = fuzzer.run(iterations);
+        std::cout << fuzzer.getCorpus().size() << " corpus messages, " << iterations << " mutations" << std::endl
+            << result.toString() << std::endl;
+
+        return result.m_violationCount == 0 ? 0 : 1;
+    }
+
     std::unique_ptr<MainWindow> mainWindow;
 };
 
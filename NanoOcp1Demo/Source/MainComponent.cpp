@@ -21,6 +21,7 @@
 #include "../../Source/NanoOcp1.h"
 #include "../../Source/Ocp1DataTypes.h"
 #include "../../Source/Ocp1DS100ObjectDefinitions.h"
+#include "../../Source/Ocp1NotificationDispatcher.h"
 
 
 namespace NanoOcp1Demo
@@ -39,6 +40,30 @@ MainComponent::MainComponent()
     m_speakerGroupObjDef = std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Positioning_Speaker_Group>(1);
     m_guidObjDef = std::make_unique<NanoOcp1::DS100::dbOcaObjectDef_Fixed_GUID>();
 
+    // Route notifications to the right GUI element according to the definition of the object
+    // which triggered them.
+    m_notificationDispatcher = std::make_unique<NanoOcp1::Ocp1NotificationDispatcher>();
+    m_notificationDispatcher->addHandler(*m_pwrOnObjDef.get(), [=](const NanoOcp1::Ocp1Notification& notification)
+    {
+        std::uint16_t switchSetting = NanoOcp1::DataToUint16(notification.GetParameterData());
+        m_powerD40LED->setToggleState(switchSetting > 0, dontSendNotification);
+    });
+    m_notificationDispatcher->addHandler(*m_potiLevelObjDef.get(), [=](const NanoOcp1::Ocp1Notification& notification)
+    {
+        std::float_t newGain = NanoOcp1::DataToFloat(notification.GetParameterData());
+        m_gainSlider->setValue(newGain, dontSendNotification);
+    });
+    m_notificationDispatcher->addHandler(*m_soundobjectEnableObjDef.get(), [=](const NanoOcp1::Ocp1Notification& notification)
+    {
+        std::uint16_t switchSetting = NanoOcp1::DataToUint16(notification.GetParameterData());
+        DBG(juce::String(__FUNCTION__) + juce::String(" Notification for Positioning_Source_Enable: ") + juce::String(switchSetting));
+    });
+    m_notificationDispatcher->addHandler(*m_speakerGroupObjDef.get(), [=](const NanoOcp1::Ocp1Notification& notification)
+    {
+        std::uint32_t newGroup = NanoOcp1::DataToUint32(notification.GetParameterData());
+        DBG(juce::String(__FUNCTION__) + juce::String(" Notification for Positioning_Speaker_Group: ") + juce::String(newGroup));
+    });
+
     // Editor to allow user input for ip address and port to use to connect
     m_ipAndPortEditor = std::make_unique<TextEditor>();
     m_ipAndPortEditor->setTextToShowWhenEmpty(address + ";" + juce::String(port), getLookAndFeel().findColour(juce::TextEditor::ColourIds::textColourId).darker().darker());
@@ -61,28 +86,13 @@ MainComponent::MainComponent()
     {
         if (m_subscribeButton->getToggleState())
         {
-            // Send AddSubscription requests
-            std::uint32_t handle;
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel(1).AddSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_potiLevelObjDef.get());
-            DBG("Sent an OCA AddSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::AmpDxDy::dbOcaObjectDef_Settings_PwrOn().AddSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_pwrOnObjDef.get());
-            DBG("Sent an OCA AddSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::DS100::dbOcaObjectDef_Positioning_Source_Enable(1).AddSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_soundobjectEnableObjDef.get());
-            DBG("Sent an OCA AddSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::DS100::dbOcaObjectDef_Positioning_Speaker_Group(1).AddSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_speakerGroupObjDef.get());
-            DBG("Sent an OCA AddSubscription command with handle " << NanoOcp1::HandleToString(handle));
+            // Let the client own the subscriptions, so that they are restored after a reconnect.
+            const NanoOcp1::Ocp1CommandDefinition* subscriptionDefs[] = {
+                m_potiLevelObjDef.get(), m_pwrOnObjDef.get(), m_soundobjectEnableObjDef.get(), m_speakerGroupObjDef.get() };
+            m_nanoOcp1Client->addSubscriptions(subscriptionDefs);
+            DBG("Added " << juce::String(static_cast<int>(m_nanoOcp1Client->getSubscriptionSet().getCount())) << " OCA subscriptions");
 
+            std::uint32_t handle;
             // Get initial values
             m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(*m_pwrOnObjDef.get(), handle).GetMemoryBlock());
             m_ocaHandleMap.emplace(handle, m_pwrOnObjDef.get());
@@ -107,26 +117,8 @@ MainComponent::MainComponent()
         else
         {
             // Send RemoveSubscription requests
-            std::uint32_t handle;
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel(1).RemoveSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_potiLevelObjDef.get());
-            DBG("Sent an OCA RemoveSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::AmpDxDy::dbOcaObjectDef_Settings_PwrOn().RemoveSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_pwrOnObjDef.get());
-            DBG("Sent an OCA RemoveSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::DS100::dbOcaObjectDef_Positioning_Source_Enable(1).RemoveSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_soundobjectEnableObjDef.get());
-            DBG("Sent an OCA RemoveSubscription command with handle " << NanoOcp1::HandleToString(handle));
-
-            m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(
-                NanoOcp1::DS100::dbOcaObjectDef_Positioning_Speaker_Group(1).RemoveSubscriptionCommand(), handle).GetMemoryBlock());
-            m_ocaHandleMap.emplace(handle, m_speakerGroupObjDef.get());
-            DBG("Sent an OCA RemoveSubscription command with handle " << NanoOcp1::HandleToString(handle));
+            m_nanoOcp1Client->clearSubscriptions();
+            DBG("Removed all OCA subscriptions");
         }
     };
     addAndMakeVisible(m_subscribeButton.get());
@@ -165,9 +157,8 @@ MainComponent::MainComponent()
     m_gainSlider->setTextValueSuffix("dB");
     m_gainSlider->onValueChange = [=]()
     {
-        std::uint32_t handle;
-        auto cmdDef(NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel(1).SetValueCommand(m_gainSlider->getValue()));
-        m_nanoOcp1Client->sendData(NanoOcp1::Ocp1CommandResponseRequired(cmdDef, handle).GetMemoryBlock());
+        // Slider drags produce far more values than the device needs, so only the most recent one is sent per flush.
+        m_nanoOcp1Client->sendCoalescedSetValue(*m_potiLevelObjDef.get(), m_gainSlider->getValue());
     };
     addAndMakeVisible(m_gainSlider.get());
 
@@ -175,6 +166,7 @@ MainComponent::MainComponent()
 
     // create the nano ocp1 client and fire it up
     m_nanoOcp1Client = std::make_unique<NanoOcp1::NanoOcp1Client>(address, port, true /* synch callbacks */);
+    m_nanoOcp1Client->setHeartbeat(1000); // Lets the client detect a device that went silent within two seconds.
     m_nanoOcp1Client->onDataReceived = [=](const NanoOcp1::ByteVector& message)
     {
         return OnOcp1MessageReceived(message);
@@ -205,29 +197,7 @@ bool MainComponent::OnOcp1MessageReceived(const NanoOcp1::ByteVector& message)
 
                     DBG("Got an OCA notification from ONo 0x" << juce::String::toHexString(notifObj->GetEmitterOno()));
 
-                    // Update the right GUI element according to the definition of the object 
-                    // which triggered the notification.
-                    if (notifObj->MatchesObject(m_pwrOnObjDef.get()))
-                    {
-                        std::uint16_t switchSetting = NanoOcp1::DataToUint16(notifObj->GetParameterData());
-                        m_powerD40LED->setToggleState(switchSetting > 0, dontSendNotification);
-                    }
-                    else if (notifObj->MatchesObject(m_potiLevelObjDef.get()))
-                    {
-                        std::float_t newGain = NanoOcp1::DataToFloat(notifObj->GetParameterData());
-                        m_gainSlider->setValue(newGain, dontSendNotification);
-                    }
-                    else if (notifObj->MatchesObject(m_soundobjectEnableObjDef.get()))
-                    {
-                        std::uint16_t switchSetting = NanoOcp1::DataToUint16(notifObj->GetParameterData());
-                        DBG(juce::String(__FUNCTION__) + juce::String(" Notification for Positioning_Source_Enable: ") + juce::String(switchSetting));
-                    }
-                    else if (notifObj->MatchesObject(m_speakerGroupObjDef.get()))
-                    {
-                        std::uint32_t newGroup = NanoOcp1::DataToUint32(notifObj->GetParameterData());
-                        DBG(juce::String(__FUNCTION__) + juce::String(" Notification for Positioning_Speaker_Group: ") + juce::String(newGroup));
-                    }
-                    else
+                    if (!m_notificationDispatcher->dispatch(*notifObj))
                     {
                         DBG("Got an OCA notification from UNKNOWN object ONo 0x" << juce::String::toHexString(notifObj->GetEmitterOno()));
                     }
@@ -295,7 +265,7 @@ bool MainComponent::OnOcp1MessageReceived(const NanoOcp1::ByteVector& message)
                 }
             case NanoOcp1::Ocp1Message::KeepAlive:
                 {
-                    // Reset online timer
+                    // Nothing to do, the heartbeat is supervised by NanoOcp1Client itself.
 
                     return true;
                 }
@@ -25,6 +25,7 @@ namespace NanoOcp1
 {
     class NanoOcp1;
     class NanoOcp1Client;
+    class Ocp1NotificationDispatcher;
     struct Ocp1CommandDefinition;
     using ByteVector = std::vector<std::uint8_t>;
 }
@@ -63,6 +64,7 @@ private:
     std::unique_ptr<NanoOcp1::Ocp1CommandDefinition>   m_speakerGroupObjDef;
     std::unique_ptr<NanoOcp1::Ocp1CommandDefinition>   m_guidObjDef;
     std::map<std::uint32_t, NanoOcp1::Ocp1CommandDefinition*> m_ocaHandleMap;
+    std::unique_ptr<NanoOcp1::Ocp1NotificationDispatcher>   m_notificationDispatcher;
 
     //==============================================================================
     std::unique_ptr<TextEditor>     m_ipAndPortEditor;
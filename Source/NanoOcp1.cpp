@@ -71,6 +71,19 @@ NanoOcp1Client::NanoOcp1Client(const bool callbacksOnMessageThread, const juce::
 NanoOcp1Client::NanoOcp1Client(const juce::String& address, const int port, const bool callbacksOnMessageThread, const juce::Thread::Priority threadPriority) :
     NanoOcp1Base(address, port), Ocp1Connection(callbacksOnMessageThread, threadPriority)
 {
+    m_latencyStats = std::make_unique<Ocp1LatencyStats>();
+    m_commandTracker = std::make_unique<Ocp1CommandTracker>(&getMetrics());
+    m_rateLimiter = std::make_unique<Ocp1RateLimiter>([this](const ByteVector& data) {
+        // Taken before writing, the response might otherwise be received first.
+        m_latencyStats->commandWritten(data);
+        return Ocp1Connection::sendMessage(data);
+    }, &getMetrics());
+    m_setCoalescer = std::make_unique<Ocp1SetCoalescer>([this](const ByteVector& data) { return sendData(data); });
+    m_subscriptionSet = std::make_unique<Ocp1SubscriptionSet>([this](const Ocp1CommandDefinition& command, const Ocp1CommandTracker::ResponseCallback& onResponse, int timeoutMs) {
+        return sendCommand(command, onResponse, timeoutMs);
+    });
+    m_meterAggregator = std::make_unique<Ocp1MeterAggregator>();
+    m_heartbeat = std::make_unique<Ocp1Heartbeat>([this](const ByteVector& data) { return sendData(data); });
 }
 
 NanoOcp1Client::~NanoOcp1Client()
@@ -96,8 +109,14 @@ bool NanoOcp1Client::stop()
 
     stopTimer();
 
+    // Get the most recent values out before the connection is closed.
+    m_setCoalescer->flush();
+
     disconnect(1000);
 
+    // Callbacks posted by disconnect are discarded, so connectionLost might not be called.
+    discardConnectionState();
+
     if (onConnectionLost && !isConnected())
         onConnectionLost();
 
@@ -114,19 +133,285 @@ bool NanoOcp1Client::sendData(const ByteVector& data)
     if (!isConnected())
         return false;
 
-    return Ocp1Connection::sendMessage(data);
+    m_latencyStats->commandEnqueued(data);
+
+    return m_rateLimiter->send(data);
+}
+
+Ocp1LatencyStats& NanoOcp1Client::getLatencyStats()
+{
+    return *m_latencyStats;
+}
+
+void NanoOcp1Client::setHeartbeat(int heartbeatMs)
+{
+    m_heartbeat->setHeartbeat(heartbeatMs);
+}
+
+int NanoOcp1Client::getHeartbeat() const
+{
+    return m_heartbeat->getHeartbeat();
+}
+
+bool NanoOcp1Client::sendCoalescedSetValue(const Ocp1CommandDefinition& def, const Variant& newValue)
+{
+    if (!isConnected())
+        return false;
+
+    return m_setCoalescer->enqueueSetValue(def, newValue);
+}
+
+Ocp1SetCoalescer& NanoOcp1Client::getSetCoalescer()
+{
+    return *m_setCoalescer;
+}
+
+Ocp1RateLimiter& NanoOcp1Client::getRateLimiter()
+{
+    return *m_rateLimiter;
+}
+
+bool NanoOcp1Client::sendCommand(const Ocp1CommandDefinition& command, const Ocp1CommandTracker::ResponseCallback& onResponse, int timeoutMs, std::uint32_t* pHandle)
+{
+    if (!isConnected())
+        return false;
+
+    std::uint32_t handle;
+    Ocp1CommandResponseRequired commandObj(command, handle);
+
+    // Track before sending, the response might otherwise arrive before it is expected.
+    m_commandTracker->track(handle, onResponse, timeoutMs);
+
+    if (!sendData(commandObj.GetMemoryBlock()))
+    {
+        m_commandTracker->untrack(handle);
+        return false;
+    }
+
+    if (pHandle != nullptr)
+        *pHandle = handle;
+
+    return true;
+}
+
+bool NanoOcp1Client::readMany(std::span<const Ocp1CommandDefinition* const> defs, const ReadManyCallback& onComplete, int timeoutMs)
+{
+    if (!isConnected())
+        return false;
+
+    struct BulkRead
+    {
+        juce::CriticalSection       m_lock;
+        std::vector<ReadResult>     m_results;
+        std::size_t                 m_outstanding{ 0 };
+        ReadManyCallback            m_onComplete;
+    };
+
+    auto bulkRead = std::make_shared<BulkRead>();
+    bulkRead->m_results.resize(defs.size());
+    bulkRead->m_outstanding = defs.size();
+    bulkRead->m_onComplete = onComplete;
+
+    // Invoked once per definition, the last invocation completes the bulk read.
+    auto completeOne = [this, bulkRead](std::size_t index, Ocp1DataType dataType, const Ocp1Response* response)
+    {
+        bool isLast = false;
+        {
+            const juce::ScopedLock sl(bulkRead->m_lock);
+
+            auto& result = bulkRead->m_results[index];
+            if (response != nullptr)
+            {
+                result.m_responded = true;
+                result.m_status = response->GetResponseStatus();
+                if (result.m_status == OCASTATUS_OK && response->GetParamCount() > 0)
+                {
+                    const auto parameterData = response->GetParameterData();
+                    result.m_value = Variant(parameterData, dataType);
+                    if (auto* mirror = m_activePropertyMirror.load(std::memory_order_acquire))
+                        mirror->update(result.m_propertyKey, parameterData);
+                }
+            }
+
+            isLast = (--bulkRead->m_outstanding == 0);
+        }
+
+        if (isLast && bulkRead->m_onComplete)
+            bulkRead->m_onComplete(bulkRead->m_results);
+    };
+
+    if (defs.empty())
+    {
+        if (onComplete)
+            onComplete(bulkRead->m_results);
+        return true;
+    }
+
+    // All Gets are pipelined, without waiting for the respective responses in between.
+    auto success = true;
+    for (std::size_t i = 0; i < defs.size(); i++)
+    {
+        const auto* def = defs[i];
+        jassert(def != nullptr);
+        auto dataType = def->GetDataType();
+
+        bulkRead->m_results[i].m_propertyKey = def->GetPropertyKey();
+
+        if (!sendCommand(def->GetValueCommand(), [completeOne, i, dataType](const Ocp1Response* response) { completeOne(i, dataType, response); }, timeoutMs))
+        {
+            completeOne(i, dataType, nullptr);
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+void NanoOcp1Client::addSubscriptions(std::span<const Ocp1CommandDefinition* const> defs)
+{
+    m_subscriptionSet->add(defs, isConnected());
+}
+
+void NanoOcp1Client::addSubscription(const Ocp1CommandDefinition& def)
+{
+    m_subscriptionSet->add(def, isConnected());
+}
+
+void NanoOcp1Client::removeSubscription(const Ocp1CommandDefinition& def)
+{
+    m_subscriptionSet->remove(def, isConnected());
+}
+
+void NanoOcp1Client::clearSubscriptions()
+{
+    m_subscriptionSet->clear(isConnected());
+}
+
+Ocp1SubscriptionSet& NanoOcp1Client::getSubscriptionSet()
+{
+    return *m_subscriptionSet;
+}
+
+Ocp1PropertyMirror& NanoOcp1Client::enablePropertyMirror(std::size_t capacity, std::size_t changeLogSize)
+{
+    const juce::ScopedLock sl(m_propertyMirrorLock);
+
+    // The capacity of the first call applies, the mirror is never reallocated.
+    if (!m_propertyMirror)
+    {
+        m_propertyMirror = std::make_unique<Ocp1PropertyMirror>(capacity, changeLogSize);
+        m_activePropertyMirror.store(m_propertyMirror.get(), std::memory_order_release);
+    }
+
+    return *m_propertyMirror;
+}
+
+bool NanoOcp1Client::mirrorProperties(std::span<const Ocp1CommandDefinition* const> defs, int timeoutMs)
+{
+    auto& mirror = enablePropertyMirror();
+
+    auto success = true;
+    for (const auto* def : defs)
+        success = mirror.addProperty(*def) && success;
+
+    // Get the initial values. Later changes arrive via notifications, if subscribed to.
+    if (isConnected())
+        success = readMany(defs, nullptr, timeoutMs) && success;
+
+    return success;
+}
+
+bool NanoOcp1Client::refreshPropertyMirror(int timeoutMs)
+{
+    const auto* mirror = getPropertyMirror();
+    if (mirror == nullptr)
+        return true;
+
+    const auto defs = mirror->getPropertyDefinitions();
+    if (defs.empty())
+        return true;
+
+    return readMany(defs, nullptr, timeoutMs);
+}
+
+const Ocp1PropertyMirror* NanoOcp1Client::getPropertyMirror() const
+{
+    return m_activePropertyMirror.load(std::memory_order_acquire);
+}
+
+bool NanoOcp1Client::savePropertySnapshot(const juce::File& file, const std::string& deviceGuid) const
+{
+    const auto* mirror = getPropertyMirror();
+    if (mirror == nullptr)
+        return false;
+
+    return Ocp1PropertySnapshot::Write(file, *mirror, deviceGuid);
+}
+
+bool NanoOcp1Client::loadPropertySnapshot(const juce::File& file, const std::string& expectedDeviceGuid)
+{
+    // Only properties already registered via mirrorProperties are taken from the snapshot.
+    auto* mirror = m_activePropertyMirror.load(std::memory_order_acquire);
+    if (mirror == nullptr)
+        return false;
+
+    Ocp1PropertySnapshot snapshot;
+    if (!snapshot.open(file))
+        return false;
+
+    if (!expectedDeviceGuid.empty() && snapshot.getDeviceGuid() != expectedDeviceGuid)
+        return false; // Snapshot of a different device.
+
+    snapshot.applyTo(*mirror);
+
+    // Reconcile with the device in the background. Without a connection, this happens once it is made.
+    if (isConnected())
+        refreshPropertyMirror();
+
+    return true;
+}
+
+void NanoOcp1Client::setMeterAggregation(bool enabled)
+{
+    m_meterAggregation = enabled;
+}
+
+bool NanoOcp1Client::isMeterAggregationEnabled() const
+{
+    return m_meterAggregation;
+}
+
+Ocp1MeterAggregator& NanoOcp1Client::getMeterAggregator()
+{
+    return *m_meterAggregator;
 }
 
 void NanoOcp1Client::connectionMade()
 {
     stopTimer();
 
+    if (m_hasBeenConnected)
+        getMetrics().add(Ocp1Metrics::Counter::Reconnects);
+    m_hasBeenConnected = true;
+
+    // Announce the heartbeat and let the reader thread detect a peer that went silent.
+    m_heartbeat->start();
+    setReceiveTimeout(m_heartbeat->getReceiveTimeout());
+
+    // The device does not know about any subscriptions of a new connection.
+    m_subscriptionSet->restore();
+
+    // Values might have changed while there was no connection.
+    refreshPropertyMirror();
+
     if (onConnectionEstablished)
         onConnectionEstablished();
 }
 
 void NanoOcp1Client::connectionLost()
 {
+    discardConnectionState();
+
     if (onConnectionLost)
         onConnectionLost();
 
@@ -134,11 +419,53 @@ void NanoOcp1Client::connectionLost()
         startTimer(500); // start trying to reestablish connection
 }
 
+bool NanoOcp1Client::preprocessMessage(const ByteVector& message)
+{
+    // Taken on the reader thread, to not measure the time spent in the message queue.
+    m_latencyStats->responseReceived(message);
+
+    // Keep the mirror up to date, before anyone else gets to see the change.
+    // Nothing to do for the reader thread as long as no property is mirrored.
+    auto* mirror = m_activePropertyMirror.load(std::memory_order_acquire);
+    if (mirror != nullptr && mirror->getPropertyCount() > 0)
+        mirror->processReceivedData(message);
+
+    // Meter notifications arrive by the hundreds per metering cycle, consume them right here
+    // instead of delivering each one on its own.
+    return m_meterAggregation && m_meterAggregator->processReceivedData(message);
+}
+
 void NanoOcp1Client::messageReceived(const ByteVector& message)
 {
+    // KeepAlives are still passed on, the application might want to see them.
+    if (message.size() > 7 && message[7] == Ocp1Message::KeepAlive)
+    {
+        // Framing errors were already counted by the reader thread.
+        auto msgObj = Ocp1Message::UnmarshalOcp1Message(message);
+        if (msgObj)
+        {
+            m_heartbeat->keepAliveReceived(*static_cast<Ocp1KeepAlive*>(msgObj.get()));
+            setReceiveTimeout(m_heartbeat->getReceiveTimeout());
+        }
+    }
+
+    // Responses to commands sent via sendCommand are handled internally.
+    if (m_commandTracker->processReceivedData(message))
+        return;
+
     processReceivedData(message);
 }
 
+void NanoOcp1Client::discardConnectionState()
+{
+    // Commands queued for a connection that is gone are stale by the time it is reestablished.
+    m_setCoalescer->clear();
+    m_rateLimiter->clear();
+    m_commandTracker->failAll();
+    m_subscriptionSet->connectionLost();
+    m_heartbeat->stop();
+}
+
 void NanoOcp1Client::timerCallback()
 {
     if (connectToSocket(getAddress(), getPort(), 50))
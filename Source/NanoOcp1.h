@@ -26,9 +26,21 @@
 #endif
 
 
+#include <span>
+
+#include "Ocp1CommandTracker.h"
 #include "Ocp1Connection.h"
 #include "Ocp1ConnectionServer.h"
 #include "Ocp1DataTypes.h"
+#include "Ocp1Heartbeat.h"
+#include "Ocp1LatencyStats.h"
+#include "Ocp1Message.h"
+#include "Ocp1MeterAggregator.h"
+#include "Ocp1PropertyMirror.h"
+#include "Ocp1PropertySnapshot.h"
+#include "Ocp1RateLimiter.h"
+#include "Ocp1SetCoalescer.h"
+#include "Ocp1SubscriptionSet.h"
 
 
 namespace NanoOcp1
@@ -72,6 +84,19 @@ private:
 
 class NanoOcp1Client : public NanoOcp1Base, public Ocp1Connection, public juce::Timer
 {
+public:
+    /**
+     * Result of reading a single property as part of readMany.
+     */
+    struct ReadResult
+    {
+        std::uint64_t   m_propertyKey{ 0 };                 // Key of the property that was read, see GetPropertyKey.
+        std::uint8_t    m_status{ OCASTATUS_TIMEOUT };      // OcaStatus of the response. OCASTATUS_TIMEOUT if none arrived.
+        bool            m_responded{ false };               // True if a response arrived in time.
+        Variant         m_value;                            // Value contained in the response, if any.
+    };
+    using ReadManyCallback = std::function<void(const std::vector<ReadResult>& results)>;
+
 public:
     //==============================================================================
     NanoOcp1Client(const bool callbacksOnMessageThread, const juce::Thread::Priority threadPriority=juce::Thread::Priority::normal);
@@ -86,18 +111,70 @@ public:
     //==============================================================================
     bool sendData(const ByteVector& data) override;
 
+    //==============================================================================
+    Ocp1LatencyStats& getLatencyStats();
+
+    //==============================================================================
+    void setHeartbeat(int heartbeatMs);
+    int getHeartbeat() const;
+
+    //==============================================================================
+    bool sendCoalescedSetValue(const Ocp1CommandDefinition& def, const Variant& newValue);
+    Ocp1SetCoalescer& getSetCoalescer();
+    Ocp1RateLimiter& getRateLimiter();
+
+    //==============================================================================
+    bool sendCommand(const Ocp1CommandDefinition& command, const Ocp1CommandTracker::ResponseCallback& onResponse, int timeoutMs = 2000, std::uint32_t* pHandle = nullptr);
+    bool readMany(std::span<const Ocp1CommandDefinition* const> defs, const ReadManyCallback& onComplete, int timeoutMs = 2000);
+
+    //==============================================================================
+    void addSubscriptions(std::span<const Ocp1CommandDefinition* const> defs);
+    void addSubscription(const Ocp1CommandDefinition& def);
+    void removeSubscription(const Ocp1CommandDefinition& def);
+    void clearSubscriptions();
+    Ocp1SubscriptionSet& getSubscriptionSet();
+
+    //==============================================================================
+    Ocp1PropertyMirror& enablePropertyMirror(std::size_t capacity = Ocp1PropertyMirror::DefaultCapacity, std::size_t changeLogSize = Ocp1PropertyMirror::DefaultChangeLogSize);
+    bool mirrorProperties(std::span<const Ocp1CommandDefinition* const> defs, int timeoutMs = 2000);
+    bool refreshPropertyMirror(int timeoutMs = 2000);
+    const Ocp1PropertyMirror* getPropertyMirror() const;
+    bool savePropertySnapshot(const juce::File& file, const std::string& deviceGuid) const;
+    bool loadPropertySnapshot(const juce::File& file, const std::string& expectedDeviceGuid = std::string());
+
+    //==============================================================================
+    void setMeterAggregation(bool enabled);
+    bool isMeterAggregationEnabled() const;
+    Ocp1MeterAggregator& getMeterAggregator();
+
     //==============================================================================
     void connectionMade() override;
     void connectionLost() override;
     void messageReceived(const ByteVector& message) override;
+    bool preprocessMessage(const ByteVector& message) override;
 
 protected:
     //==============================================================================
     void timerCallback() override;
 
 private:
+    //==============================================================================
+    void discardConnectionState();
+
     //==============================================================================
     bool m_running{ false };
+    bool m_hasBeenConnected{ false };
+    std::unique_ptr<Ocp1CommandTracker> m_commandTracker;
+    std::unique_ptr<Ocp1RateLimiter> m_rateLimiter;
+    std::unique_ptr<Ocp1SetCoalescer> m_setCoalescer;
+    std::unique_ptr<Ocp1SubscriptionSet> m_subscriptionSet;
+    juce::CriticalSection m_propertyMirrorLock;
+    std::unique_ptr<Ocp1PropertyMirror> m_propertyMirror; // Created on demand, never replaced.
+    std::atomic<Ocp1PropertyMirror*> m_activePropertyMirror{ nullptr }; // Published for the reader thread.
+    std::unique_ptr<Ocp1MeterAggregator> m_meterAggregator;
+    std::atomic<bool> m_meterAggregation{ false };
+    std::unique_ptr<Ocp1Heartbeat> m_heartbeat;
+    std::unique_ptr<Ocp1LatencyStats> m_latencyStats;
 };
 
 class NanoOcp1Server : public NanoOcp1Base, public Ocp1ConnectionServer
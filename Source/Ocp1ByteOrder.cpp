@@ -0,0 +1,178 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1ByteOrder.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define NANOOCP1_BYTESWAP_AVX2 1
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+    #include <tmmintrin.h>
+    #define NANOOCP1_BYTESWAP_SSSE3 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define NANOOCP1_BYTESWAP_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define NANOOCP1_BYTESWAP_NEON 1
+#endif
+
+
+namespace NanoOcp1
+{
+
+namespace
+{
+
+/**
+ * Scalar byte swap of the values from index start on, for the remainder of the vectorized loops.
+ */
+template <typename T>
+void ByteSwapCopyScalar(const std::uint8_t* source, std::uint8_t* destination, std::size_t start, std::size_t count) noexcept
+{
+    for (auto i = start; i < count; i++)
+    {
+        T value;
+        std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+        value = ByteSwap(value);
+        std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+#if NANOOCP1_BYTESWAP_SSE2
+/**
+ * Reverses the bytes within each 16 bit lane, the first step of all SSE2 swaps.
+ */
+inline __m128i ByteSwap16Lanes(__m128i value) noexcept
+{
+    return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+
+/**
+ * Reverses the bytes within each 32 bit lane.
+ */
+inline __m128i ByteSwap32Lanes(__m128i value) noexcept
+{
+    value = ByteSwap16Lanes(value);
+    value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+}
+#endif
+
+/**
+ * Vectorized byte swap of as many whole vectors as fit into count values of size Size.
+ *
+ * @return  Number of values converted.
+ */
+template <std::size_t Size>
+std::size_t ByteSwapCopyVectorized(const std::uint8_t* source, std::uint8_t* destination, std::size_t count) noexcept
+{
+    [[maybe_unused]] constexpr std::size_t valuesPerVector = 16 / Size;
+    std::size_t i = 0;
+
+#if NANOOCP1_BYTESWAP_AVX2
+    {
+        const auto mask = Size == 2 ? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                                       1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                        : Size == 4 ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                       3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                    : _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                       7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (; i + 2 * valuesPerVector <= count; i += 2 * valuesPerVector)
+        {
+            auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * Size));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * Size), _mm256_shuffle_epi8(value, mask));
+        }
+    }
+#endif
+
+#if NANOOCP1_BYTESWAP_SSSE3
+    const auto mask = Size == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                    : Size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for (; i + valuesPerVector <= count; i += valuesPerVector)
+    {
+        auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * Size));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * Size), _mm_shuffle_epi8(value, mask));
+    }
+#elif NANOOCP1_BYTESWAP_SSE2
+    for (; i + valuesPerVector <= count; i += valuesPerVector)
+    {
+        auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * Size));
+        if constexpr (Size == 2)
+            value = ByteSwap16Lanes(value);
+        else if constexpr (Size == 4)
+            value = ByteSwap32Lanes(value);
+        else
+            value = _mm_shuffle_epi32(ByteSwap32Lanes(value), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * Size), value);
+    }
+#elif NANOOCP1_BYTESWAP_NEON
+    for (; i + valuesPerVector <= count; i += valuesPerVector)
+    {
+        auto value = vld1q_u8(source + i * Size);
+        if constexpr (Size == 2)
+            value = vrev16q_u8(value);
+        else if constexpr (Size == 4)
+            value = vrev32q_u8(value);
+        else
+            value = vrev64q_u8(value);
+        vst1q_u8(destination + i * Size, value);
+    }
+#else
+    static_cast<void>(source);
+    static_cast<void>(destination);
+    static_cast<void>(count);
+#endif
+
+    return i;
+}
+
+template <typename T>
+void ByteSwapCopy(const void* source, void* destination, std::size_t count) noexcept
+{
+    auto* src = static_cast<const std::uint8_t*>(source);
+    auto* dst = static_cast<std::uint8_t*>(destination);
+
+    auto converted = ByteSwapCopyVectorized<sizeof(T)>(src, dst, count);
+    ByteSwapCopyScalar<T>(src, dst, converted, count);
+}
+
+}
+
+
+//==============================================================================
+void ByteSwapCopy16(const void* source, void* destination, std::size_t count) noexcept
+{
+    ByteSwapCopy<std::uint16_t>(source, destination, count);
+}
+
+void ByteSwapCopy32(const void* source, void* destination, std::size_t count) noexcept
+{
+    ByteSwapCopy<std::uint32_t>(source, destination, count);
+}
+
+void ByteSwapCopy64(const void* source, void* destination, std::size_t count) noexcept
+{
+    ByteSwapCopy<std::uint64_t>(source, destination, count);
+}
+
+
+}
@@ -0,0 +1,212 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <bit>          //< USE std::bit_cast, std::endian, std::byteswap
+#include <cstddef>      //< USE std::size_t
+#include <cstdint>      //< USE std::uint8_t .. std::uint64_t
+#include <cstring>      //< USE std::memcpy
+#include <type_traits>  //< USE std::is_integral_v, std::is_constant_evaluated
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <stdlib.h> //< USE _byteswap_ushort, _byteswap_ulong, _byteswap_uint64
+#endif
+
+namespace NanoOcp1
+{
+
+/**
+ * Unsigned integer type with the same size as T, used as the raw representation
+ * of fixed-size OCP.1 values on the wire.
+ */
+template <typename T>
+using ByteOrderRawType = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                         std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+/**
+ * Reverses the byte order of an unsigned integer.
+ * Maps to std::byteswap where available and to the compiler builtins otherwise,
+ * so that it compiles down to a single bswap/rev instruction.
+ *
+ * @param[in] value     Value to swap.
+ * @return  The value with reversed byte order.
+ */
+template <typename T>
+constexpr T ByteSwap(T value) noexcept
+{
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "ByteSwap requires an unsigned integer type");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported integer size");
+
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#else
+    if constexpr (sizeof(T) == 1)
+    {
+        return value;
+    }
+    else
+    {
+        if (std::is_constant_evaluated())
+        {
+            T ret(0);
+            for (std::size_t i = 0; i < sizeof(T); i++)
+                ret = static_cast<T>((ret << 8) | ((value >> (8 * i)) & 0xff));
+            return ret;
+        }
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        if constexpr (sizeof(T) == 2)
+            return static_cast<T>(_byteswap_ushort(value));
+        else if constexpr (sizeof(T) == 4)
+            return static_cast<T>(_byteswap_ulong(value));
+        else
+            return static_cast<T>(_byteswap_uint64(value));
+    #else
+        if constexpr (sizeof(T) == 2)
+            return static_cast<T>(__builtin_bswap16(value));
+        else if constexpr (sizeof(T) == 4)
+            return static_cast<T>(__builtin_bswap32(value));
+        else
+            return static_cast<T>(__builtin_bswap64(value));
+    #endif
+    }
+#endif
+}
+
+/**
+ * Reads a fixed-size big-endian (network byte order) value from a buffer.
+ * Works for integer and floating point types of 1, 2, 4 or 8 bytes. The buffer does not
+ * need to be aligned; outside of constant evaluation this is a single (unaligned) load
+ * followed by a byte swap on little-endian targets.
+ *
+ * @param[in] buffer    Pointer to at least sizeof(T) readable bytes.
+ * @return  The decoded value.
+ */
+template <typename T>
+constexpr T LoadBigEndian(const std::uint8_t* buffer) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "LoadBigEndian requires an arithmetic type");
+    using RawType = ByteOrderRawType<T>;
+    static_assert(sizeof(RawType) == sizeof(T), "Unsupported type size");
+
+    RawType raw(0);
+    if (std::is_constant_evaluated())
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            raw = static_cast<RawType>((static_cast<std::uint64_t>(raw) << 8) | buffer[i]);
+    }
+    else
+    {
+        std::memcpy(&raw, buffer, sizeof(RawType));
+        if constexpr (std::endian::native == std::endian::little)
+            raw = ByteSwap(raw);
+    }
+
+    return std::bit_cast<T>(raw);
+}
+
+/**
+ * Writes a fixed-size value to a buffer in big-endian (network byte order).
+ * Counterpart of LoadBigEndian.
+ *
+ * @param[in] buffer    Pointer to at least sizeof(T) writable bytes.
+ * @param[in] value     Value to encode.
+ */
+template <typename T>
+constexpr void StoreBigEndian(std::uint8_t* buffer, T value) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "StoreBigEndian requires an arithmetic type");
+    using RawType = ByteOrderRawType<T>;
+    static_assert(sizeof(RawType) == sizeof(T), "Unsupported type size");
+
+    auto raw = std::bit_cast<RawType>(value);
+    if (std::is_constant_evaluated())
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+            buffer[i] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(raw) >> (8 * (sizeof(T) - 1 - i)));
+    }
+    else
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            raw = ByteSwap(raw);
+        std::memcpy(buffer, &raw, sizeof(RawType));
+    }
+}
+
+/**
+ * Copies count 16, 32 or 64 bit values while reversing the byte order of each.
+ * Vectorized with AVX2, SSSE3, SSE2 or NEON, depending on what the build targets,
+ * and scalar for the remainder. Source and destination may be the same buffer but must
+ * not overlap otherwise. Neither needs to be aligned.
+ *
+ * @param[in] source        Values to read.
+ * @param[in] destination   Buffer of at least count values to write to.
+ * @param[in] count         Number of values, not bytes.
+ */
+void ByteSwapCopy16(const void* source, void* destination, std::size_t count) noexcept;
+void ByteSwapCopy32(const void* source, void* destination, std::size_t count) noexcept;
+void ByteSwapCopy64(const void* source, void* destination, std::size_t count) noexcept;
+
+/**
+ * Bulk version of LoadBigEndian: decodes count contiguous big-endian values, e.g. the
+ * floats of a position or the elements of a list, into native order.
+ *
+ * @param[in] buffer        Pointer to at least count * sizeof(T) readable bytes.
+ * @param[in] destination   Array of at least count values to write to.
+ * @param[in] count         Number of values.
+ */
+template <typename T>
+void LoadBigEndianArray(const std::uint8_t* buffer, T* destination, std::size_t count) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "Unsupported type");
+
+    if constexpr (std::endian::native == std::endian::big)
+        std::memcpy(destination, buffer, count * sizeof(T));
+    else if constexpr (sizeof(T) == 2)
+        ByteSwapCopy16(buffer, destination, count);
+    else if constexpr (sizeof(T) == 4)
+        ByteSwapCopy32(buffer, destination, count);
+    else
+        ByteSwapCopy64(buffer, destination, count);
+}
+
+/**
+ * Bulk version of StoreBigEndian: encodes count values into contiguous big-endian.
+ *
+ * @param[in] buffer    Pointer to at least count * sizeof(T) writable bytes.
+ * @param[in] source    Array of at least count values to encode.
+ * @param[in] count     Number of values.
+ */
+template <typename T>
+void StoreBigEndianArray(std::uint8_t* buffer, const T* source, std::size_t count) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "Unsupported type");
+
+    if constexpr (std::endian::native == std::endian::big)
+        std::memcpy(buffer, source, count * sizeof(T));
+    else if constexpr (sizeof(T) == 2)
+        ByteSwapCopy16(source, buffer, count);
+    else if constexpr (sizeof(T) == 4)
+        ByteSwapCopy32(source, buffer, count);
+    else
+        ByteSwapCopy64(source, buffer, count);
+}
+
+}
@@ -0,0 +1,292 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1CaptureFile.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1CaptureWriter::Ocp1CaptureWriter(std::unique_ptr<juce::OutputStream> stream, std::int64_t startTimeMs)
+    : m_stream(std::move(stream)), m_startTimeMs(startTimeMs)
+{
+    if (m_stream == nullptr)
+        return;
+
+    m_ok = m_stream->write(Magic, sizeof(Magic))
+        && m_stream->writeShortBigEndian(static_cast<short>(FormatVersion))
+        && m_stream->writeShortBigEndian(0)
+        && m_stream->writeInt64BigEndian(m_startTimeMs);
+}
+
+Ocp1CaptureWriter::Ocp1CaptureWriter(const juce::File& file, std::int64_t startTimeMs)
+    : Ocp1CaptureWriter([&file]() -> std::unique_ptr<juce::OutputStream> {
+            auto stream = std::make_unique<juce::FileOutputStream>(file);
+            if (!stream->openedOk() || !stream->setPosition(0) || stream->truncate().failed())
+                return nullptr;
+            return stream;
+        }(), startTimeMs)
+{
+}
+
+Ocp1CaptureWriter::~Ocp1CaptureWriter()
+{
+    flush();
+}
+
+//==============================================================================
+bool Ocp1CaptureWriter::isOk() const
+{
+    return m_ok;
+}
+
+std::int64_t Ocp1CaptureWriter::getStartTimeMs() const
+{
+    return m_startTimeMs;
+}
+
+bool Ocp1CaptureWriter::write(const Ocp1CaptureRecord& record)
+{
+    return writeRecord(record.m_direction, record.m_timeUs, record.m_size, record.m_data.data(), record.m_data.size());
+}
+
+bool Ocp1CaptureWriter::write(const Ocp1WireCapture::Record& record, std::int64_t startTicks)
+{
+    auto timeUs = static_cast<std::int64_t>(juce::Time::highResolutionTicksToSeconds(record.m_ticks - startTicks) * 1000000.0);
+    return writeRecord(record.m_direction, timeUs, record.m_size, record.m_data.data(), record.m_data.size());
+}
+
+bool Ocp1CaptureWriter::flush()
+{
+    if (m_stream == nullptr)
+        return false;
+
+    m_stream->flush();
+    return m_ok;
+}
+
+bool Ocp1CaptureWriter::writeRecord(Ocp1WireCapture::Direction direction, std::int64_t timeUs, std::uint32_t size, const std::uint8_t* data, std::size_t capturedSize)
+{
+    if (!m_ok)
+        return false;
+
+    jassert(capturedSize <= size && capturedSize <= MaxRecordSize);
+
+    m_ok = m_stream->writeByte(static_cast<char>(direction))
+        && m_stream->writeByte(0)
+        && m_stream->writeShortBigEndian(0)
+        && m_stream->writeIntBigEndian(static_cast<int>(size))
+        && m_stream->writeIntBigEndian(static_cast<int>(capturedSize))
+        && m_stream->writeInt64BigEndian(timeUs)
+        && (capturedSize == 0 || m_stream->write(data, capturedSize));
+
+    return m_ok;
+}
+
+std::int64_t Ocp1CaptureWriter::TicksToTimeMillis(std::int64_t ticks)
+{
+    auto ageMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticks) * 1000.0;
+    return juce::Time::currentTimeMillis() - static_cast<std::int64_t>(ageMs);
+}
+
+
+//==============================================================================
+Ocp1CaptureReader::Ocp1CaptureReader(std::unique_ptr<juce::InputStream> stream)
+    : m_stream(std::move(stream))
+{
+    if (m_stream == nullptr || m_stream->getNumBytesRemaining() < 16)
+        return;
+
+    std::uint8_t magic[4] = {};
+    m_stream->read(magic, sizeof(magic));
+    auto version = static_cast<std::uint16_t>(m_stream->readShortBigEndian());
+    m_stream->readShortBigEndian(); // Reserved
+    m_startTimeMs = m_stream->readInt64BigEndian();
+
+    m_ok = std::equal(std::begin(magic), std::end(magic), std::begin(Ocp1CaptureWriter::Magic))
+        && version == Ocp1CaptureWriter::FormatVersion;
+}
+
+Ocp1CaptureReader::Ocp1CaptureReader(const juce::File& file)
+    : Ocp1CaptureReader([&file]() -> std::unique_ptr<juce::InputStream> {
+            auto stream = std::make_unique<juce::FileInputStream>(file);
+            if (!stream->openedOk())
+                return nullptr;
+            return stream;
+        }())
+{
+}
+
+Ocp1CaptureReader::~Ocp1CaptureReader()
+{
+}
+
+//==============================================================================
+bool Ocp1CaptureReader::isOk() const
+{
+    return m_ok;
+}
+
+std::int64_t Ocp1CaptureReader::getStartTimeMs() const
+{
+    return m_startTimeMs;
+}
+
+bool Ocp1CaptureReader::readNext(Ocp1CaptureRecord& record)
+{
+    constexpr std::int64_t recordHeaderSize = 20;
+
+    if (!m_ok || m_stream->getNumBytesRemaining() < recordHeaderSize)
+        return false;
+
+    auto direction = static_cast<std::uint8_t>(m_stream->readByte());
+    m_stream->readByte();           // Reserved
+    m_stream->readShortBigEndian(); // Reserved
+    auto size = static_cast<std::uint32_t>(m_stream->readIntBigEndian());
+    auto capturedSize = static_cast<std::uint32_t>(m_stream->readIntBigEndian());
+    auto timeUs = m_stream->readInt64BigEndian();
+
+    if (direction > static_cast<std::uint8_t>(Ocp1WireCapture::Direction::Sent)
+        || capturedSize > size
+        || capturedSize > Ocp1CaptureWriter::MaxRecordSize
+        || m_stream->getNumBytesRemaining() < static_cast<std::int64_t>(capturedSize))
+    {
+        m_ok = false;
+        return false;
+    }
+
+    record.m_direction = static_cast<Ocp1WireCapture::Direction>(direction);
+    record.m_timeUs = timeUs;
+    record.m_size = size;
+    record.m_data.resize(capturedSize);
+    if (capturedSize > 0 && m_stream->read(record.m_data.data(), static_cast<int>(capturedSize)) != static_cast<int>(capturedSize))
+    {
+        m_ok = false;
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<Ocp1CaptureRecord> Ocp1CaptureReader::ReadAll(const juce::File& file, bool* pOk)
+{
+    Ocp1CaptureReader reader(file);
+    if (pOk != nullptr)
+        *pOk = reader.isOk();
+
+    std::vector<Ocp1CaptureRecord> records;
+    Ocp1CaptureRecord record;
+    while (reader.readNext(record))
+        records.push_back(std::move(record));
+
+    return records;
+}
+
+
+//==============================================================================
+Ocp1CaptureRecorder::Ocp1CaptureRecorder(const Ocp1WireCapture& wireCapture, int drainIntervalMs)
+    : juce::Thread("NanoOcp1 capture recorder"), m_wireCapture(wireCapture), m_drainIntervalMs(juce::jmax(1, drainIntervalMs))
+{
+}
+
+Ocp1CaptureRecorder::~Ocp1CaptureRecorder()
+{
+    stop();
+}
+
+//==============================================================================
+bool Ocp1CaptureRecorder::start(const juce::File& file)
+{
+    stop();
+
+    m_startTicks = juce::Time::getHighResolutionTicks();
+    m_captureIndex = m_wireCapture.getCapturedCount();
+    m_recordedCount = 0;
+    m_droppedCount = 0;
+
+    m_writer = std::make_unique<Ocp1CaptureWriter>(file, Ocp1CaptureWriter::TicksToTimeMillis(m_startTicks));
+    if (!m_writer->isOk())
+    {
+        m_writer.reset();
+        return false;
+    }
+
+    startThread();
+    return true;
+}
+
+void Ocp1CaptureRecorder::stop()
+{
+    if (m_writer == nullptr)
+        return;
+
+    stopThread(1000);
+
+    // Whatever was captured until now still belongs to the recording.
+    drain();
+    m_writer.reset();
+}
+
+bool Ocp1CaptureRecorder::isRecording() const
+{
+    return isThreadRunning();
+}
+
+std::uint64_t Ocp1CaptureRecorder::getRecordedCount() const
+{
+    return m_recordedCount;
+}
+
+std::uint64_t Ocp1CaptureRecorder::getDroppedCount() const
+{
+    return m_droppedCount;
+}
+
+//==============================================================================
+void Ocp1CaptureRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(m_drainIntervalMs);
+        drain();
+    }
+}
+
+void Ocp1CaptureRecorder::drain()
+{
+    std::uint64_t droppedCount = 0;
+    auto records = m_wireCapture.getRecordsSince(m_captureIndex, &droppedCount);
+    m_droppedCount += droppedCount;
+
+    for (const auto& record : records)
+    {
+        if (!m_writer->write(record, m_startTicks))
+        {
+            m_droppedCount += 1;
+            continue;
+        }
+
+        m_recordedCount++;
+    }
+
+    m_writer->flush();
+}
+
+}
@@ -0,0 +1,233 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1WireCapture.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    A single record of a capture file.
+*/
+struct Ocp1CaptureRecord
+{
+    Ocp1WireCapture::Direction  m_direction{ Ocp1WireCapture::Direction::Received };
+    std::int64_t                m_timeUs{ 0 };  // Time since the start of the capture.
+    std::uint32_t               m_size{ 0 };    // Original size of the message.
+    ByteVector                  m_data;         // Captured bytes.
+
+    bool isTruncated() const { return m_data.size() < m_size; }
+};
+
+
+//==============================================================================
+/**
+    Writes a capture file record by record.
+
+    A capture file is a stream of OCA messages as they were sent and received on one connection.
+    It consists of a file header followed by any number of records, up to the end of the file.
+    Records are appended as they come in, so a capture can be written and read incrementally.
+    All values are big endian, like in OCP.1.
+
+    File header (16 bytes):
+        4   Magic "NOCP"
+        u16 Format version (1)
+        u16 Reserved, 0
+        i64 Start time of the capture, in milliseconds since the epoch
+
+    Record header (20 bytes), followed by the captured bytes:
+        u8  Direction, as seen from the capturing side: 0 received, 1 sent
+        u8  Reserved, 0
+        u16 Reserved, 0
+        u32 Original size of the message in bytes
+        u32 Captured size in bytes, smaller than the original size if the message was truncated
+        i64 Time the message was captured, in microseconds since the start time
+
+    Readers must skip unknown reserved values and stop at a record that does not fit the file,
+    which is what a capture cut short by a crash looks like.
+*/
+class Ocp1CaptureWriter
+{
+public:
+    static constexpr std::uint8_t Magic[4] = { 'N', 'O', 'C', 'P' };
+    static constexpr std::uint16_t FormatVersion = 1;
+    static constexpr std::uint32_t MaxRecordSize = 0x1000000; // Larger records are considered corrupt by readers.
+
+public:
+    //==============================================================================
+    /**
+     * Class constructor. Writes the file header right away.
+     *
+     * @param[in] stream        Stream to write to.
+     * @param[in] startTimeMs   Start time of the capture, in milliseconds since the epoch.
+     */
+    Ocp1CaptureWriter(std::unique_ptr<juce::OutputStream> stream, std::int64_t startTimeMs);
+
+    /**
+     * Class constructor. Replaces the contents of the given file.
+     */
+    Ocp1CaptureWriter(const juce::File& file, std::int64_t startTimeMs);
+    ~Ocp1CaptureWriter();
+
+    //==============================================================================
+    /**
+     * True if the stream could be opened and nothing failed to be written so far.
+     */
+    bool isOk() const;
+    std::int64_t getStartTimeMs() const;
+
+    bool write(const Ocp1CaptureRecord& record);
+
+    /**
+     * Writes a record read from a Ocp1WireCapture.
+     *
+     * @param[in] record        Record to write.
+     * @param[in] startTicks    High resolution ticks corresponding to the start time of the capture.
+     */
+    bool write(const Ocp1WireCapture::Record& record, std::int64_t startTicks);
+
+    bool flush();
+
+    //==============================================================================
+    /**
+     * Converts a juce::Time::getHighResolutionTicks value of the recent past to milliseconds since the epoch.
+     */
+    static std::int64_t TicksToTimeMillis(std::int64_t ticks);
+
+private:
+    //==============================================================================
+    bool writeRecord(Ocp1WireCapture::Direction direction, std::int64_t timeUs, std::uint32_t size, const std::uint8_t* data, std::size_t capturedSize);
+
+    //==============================================================================
+    std::unique_ptr<juce::OutputStream> m_stream;
+    std::int64_t                        m_startTimeMs{ 0 };
+    bool                                m_ok{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1CaptureWriter)
+};
+
+
+//==============================================================================
+/**
+    Reads a capture file record by record.
+*/
+class Ocp1CaptureReader
+{
+public:
+    //==============================================================================
+    /**
+     * Class constructor. Reads and validates the file header right away.
+     */
+    explicit Ocp1CaptureReader(std::unique_ptr<juce::InputStream> stream);
+    explicit Ocp1CaptureReader(const juce::File& file);
+    ~Ocp1CaptureReader();
+
+    //==============================================================================
+    /**
+     * True if the file header is valid.
+     */
+    bool isOk() const;
+    std::int64_t getStartTimeMs() const;
+
+    /**
+     * Reads the next record.
+     *
+     * @param[out] record   Record read.
+     * @return  False at the end of the capture, or if the next record is corrupt or incomplete.
+     */
+    bool readNext(Ocp1CaptureRecord& record);
+
+    /**
+     * Reads all records of the given capture file.
+     *
+     * @param[in] file      Capture file to read.
+     * @param[out] pOk      Optional. Set to false if the file header is invalid.
+     */
+    static std::vector<Ocp1CaptureRecord> ReadAll(const juce::File& file, bool* pOk = nullptr);
+
+private:
+    //==============================================================================
+    std::unique_ptr<juce::InputStream>  m_stream;
+    std::int64_t                        m_startTimeMs{ 0 };
+    bool                                m_ok{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1CaptureReader)
+};
+
+
+//==============================================================================
+/**
+    Continuously writes everything captured by a Ocp1WireCapture to a capture file,
+    for recordings longer than the ring holds. The ring is drained periodically on a
+    background thread, so capturing stays as cheap as without the recorder. Records
+    overwritten before they could be drained are counted as dropped.
+*/
+class Ocp1CaptureRecorder : private juce::Thread
+{
+public:
+    //==============================================================================
+    /**
+     * Class constructor.
+     *
+     * @param[in] wireCapture       Ring to drain. Must outlive the recorder.
+     * @param[in] drainIntervalMs   Time between draining the ring.
+     */
+    explicit Ocp1CaptureRecorder(const Ocp1WireCapture& wireCapture, int drainIntervalMs = 20);
+    ~Ocp1CaptureRecorder() override;
+
+    //==============================================================================
+    /**
+     * Starts recording everything captured from now on into the given file, replacing its contents.
+     */
+    bool start(const juce::File& file);
+    void stop();
+    bool isRecording() const;
+
+    std::uint64_t getRecordedCount() const;
+    std::uint64_t getDroppedCount() const;
+
+private:
+    //==============================================================================
+    void run() override;
+    void drain();
+
+    //==============================================================================
+    const Ocp1WireCapture&              m_wireCapture;
+    int                                 m_drainIntervalMs{ 20 };
+
+    std::unique_ptr<Ocp1CaptureWriter>  m_writer;
+    std::uint64_t                       m_captureIndex{ 0 };    // Next capture index to drain.
+    std::int64_t                        m_startTicks{ 0 };
+    std::atomic<std::uint64_t>          m_recordedCount{ 0 };
+    std::atomic<std::uint64_t>          m_droppedCount{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1CaptureRecorder)
+};
+
+}
@@ -0,0 +1,162 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1CaptureReplay.h"
+#include "NanoOcp1.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1CaptureReplay::Ocp1CaptureReplay(std::vector<Ocp1CaptureRecord> records)
+    : juce::Thread("NanoOcp1 capture replay"), m_records(std::move(records))
+{
+}
+
+Ocp1CaptureReplay::~Ocp1CaptureReplay()
+{
+    stop();
+}
+
+std::unique_ptr<Ocp1CaptureReplay> Ocp1CaptureReplay::FromFile(const juce::File& file)
+{
+    auto ok = false;
+    auto records = Ocp1CaptureReader::ReadAll(file, &ok);
+    if (!ok)
+        return nullptr;
+
+    return std::make_unique<Ocp1CaptureReplay>(std::move(records));
+}
+
+//==============================================================================
+const std::vector<Ocp1CaptureRecord>& Ocp1CaptureReplay::getRecords() const
+{
+    return m_records;
+}
+
+std::size_t Ocp1CaptureReplay::getRecordCount(Direction direction) const
+{
+    return static_cast<std::size_t>(std::count_if(m_records.begin(), m_records.end(),
+        [direction](const auto& record) { return record.m_direction == direction; }));
+}
+
+//==============================================================================
+std::size_t Ocp1CaptureReplay::replay(const DeliverFunction& deliver, Timing timing, Direction direction)
+{
+    if (!deliver)
+        return 0;
+
+    auto startMs = juce::Time::getMillisecondCounterHiRes();
+    std::int64_t firstTimeUs = -1;
+    std::size_t deliveredCount = 0;
+
+    for (const auto& record : m_records)
+    {
+        if (record.m_direction != direction || record.isTruncated())
+            continue;
+
+        if (timing == Timing::Original)
+        {
+            if (firstTimeUs < 0)
+                firstTimeUs = record.m_timeUs;
+
+            if (!waitUntil(startMs + static_cast<double>(record.m_timeUs - firstTimeUs) * 0.001))
+                break;
+        }
+        else if (threadShouldExit())
+            break;
+
+        deliver(record.m_data);
+        deliveredCount++;
+    }
+
+    return deliveredCount;
+}
+
+bool Ocp1CaptureReplay::start(const DeliverFunction& deliver, Timing timing, Direction direction)
+{
+    stop();
+
+    if (!deliver)
+        return false;
+
+    m_deliver = deliver;
+    m_timing = timing;
+    m_direction = direction;
+
+    return startThread();
+}
+
+void Ocp1CaptureReplay::stop()
+{
+    stopThread(2000);
+}
+
+bool Ocp1CaptureReplay::isReplaying() const
+{
+    return isThreadRunning();
+}
+
+//==============================================================================
+Ocp1CaptureReplay::DeliverFunction Ocp1CaptureReplay::ToReceivePath(Ocp1Connection& connection)
+{
+    return [&connection](const ByteVector& message) {
+        if (!connection.preprocessMessage(message))
+            connection.messageReceived(message);
+    };
+}
+
+Ocp1CaptureReplay::DeliverFunction Ocp1CaptureReplay::ToPeers(NanoOcp1Base& nanoOcp1)
+{
+    return [&nanoOcp1](const ByteVector& message) {
+        nanoOcp1.sendData(message);
+    };
+}
+
+//==============================================================================
+void Ocp1CaptureReplay::run()
+{
+    auto deliveredCount = replay(m_deliver, m_timing, m_direction);
+
+    if (onFinished)
+        onFinished(deliveredCount);
+}
+
+bool Ocp1CaptureReplay::waitUntil(double targetMs)
+{
+    // Wait most of the time, then spin for the last bit to keep the original timing accurate.
+    // Unlike sleeping, waiting is woken by stopThread, so idle gaps in the capture do not delay stopping.
+    for (;;)
+    {
+        if (threadShouldExit())
+            return false;
+
+        auto remainingMs = targetMs - juce::Time::getMillisecondCounterHiRes();
+        if (remainingMs <= 0.0)
+            return true;
+
+        if (remainingMs > 2.0)
+            wait(juce::jmin(static_cast<int>(remainingMs) - 1, MaxWaitMs));
+        else
+            juce::Thread::yield();
+    }
+}
+
+}
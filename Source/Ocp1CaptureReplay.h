@@ -0,0 +1,127 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1CaptureFile.h"
+
+
+namespace NanoOcp1
+{
+
+class NanoOcp1Base;
+class Ocp1Connection;
+
+
+//==============================================================================
+/**
+    Replays the messages of a capture, e.g. to reproduce a problem seen in the field offline.
+
+    The messages of one direction are passed, in capture order, to a DeliverFunction.
+    Ready made ones feed them into the receive path of a connection, just like its reader
+    thread would (see ToReceivePath), or send them to the peers of a NanoOcp1Server
+    (see ToPeers). Replaying either keeps the original timing between the messages or
+    runs as fast as possible, which makes the result independent of the machine's timing.
+*/
+class Ocp1CaptureReplay : private juce::Thread
+{
+public:
+    enum class Timing
+    {
+        Original,           // Keep the time between messages as captured.
+        AsFastAsPossible    // Deliver back to back.
+    };
+
+    using DeliverFunction = std::function<void(const ByteVector& message)>;
+    using Direction = Ocp1WireCapture::Direction;
+
+public:
+    //==============================================================================
+    explicit Ocp1CaptureReplay(std::vector<Ocp1CaptureRecord> records);
+    ~Ocp1CaptureReplay() override;
+
+    /**
+     * Creates a replay of the given capture file.
+     *
+     * @return  The replay, or nullptr if the file is not a valid capture file.
+     */
+    static std::unique_ptr<Ocp1CaptureReplay> FromFile(const juce::File& file);
+
+    //==============================================================================
+    const std::vector<Ocp1CaptureRecord>& getRecords() const;
+    std::size_t getRecordCount(Direction direction) const;
+
+    //==============================================================================
+    /**
+     * Replays the messages on the calling thread and returns once done.
+     *
+     * @param[in] deliver       Function to pass each message to.
+     * @param[in] timing        Whether to keep the original timing.
+     * @param[in] direction     Messages to replay. Defaults to the ones received by the capturing side.
+     * @return  The number of messages delivered. Truncated messages are skipped, since they cannot be decoded.
+     */
+    std::size_t replay(const DeliverFunction& deliver, Timing timing, Direction direction = Direction::Received);
+
+    /**
+     * Replays the messages on a background thread. The deliver function and onFinished are called on that thread.
+     */
+    bool start(const DeliverFunction& deliver, Timing timing, Direction direction = Direction::Received);
+    void stop();
+    bool isReplaying() const;
+
+    /**
+     * Invoked on the replay thread once the replay started by start finished, with the number of messages delivered.
+     */
+    std::function<void(std::size_t)> onFinished;
+
+    //==============================================================================
+    /**
+     * Delivers to preprocessMessage and, unless consumed there, messageReceived of the given connection, on the replaying thread.
+     * The connection does not need to be connected.
+     */
+    static DeliverFunction ToReceivePath(Ocp1Connection& connection);
+
+    /**
+     * Delivers via sendData, e.g. to serve a capture from a NanoOcp1Server to a connected client.
+     */
+    static DeliverFunction ToPeers(NanoOcp1Base& nanoOcp1);
+
+private:
+    //==============================================================================
+    void run() override;
+    bool waitUntil(double targetMs);
+
+    static constexpr int MaxWaitMs = 100;   // Longest single wait, so exit requests are seen even if no one notifies.
+
+    //==============================================================================
+    std::vector<Ocp1CaptureRecord>  m_records;
+
+    DeliverFunction                 m_deliver;      // Used by the background thread.
+    Timing                          m_timing{ Timing::AsFastAsPossible };
+    Direction                       m_direction{ Direction::Received };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1CaptureReplay)
+};
+
+}
@@ -0,0 +1,597 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <array>        //< USE std::array
+#include <span>         //< USE std::span, std::dynamic_extent
+#include <string>       //< USE std::string
+#include <type_traits>  //< USE std::is_arithmetic_v, std::is_enum_v
+#include <vector>       //< USE std::vector
+
+#include "Ocp1ByteOrder.h"
+#include "Ocp1DataTypes.h"
+
+namespace NanoOcp1
+{
+
+/**
+ * Value of Ocp1Codec<T>::Size for types whose marshaled size depends on the value.
+ */
+inline constexpr std::size_t Ocp1VariableSize = std::dynamic_extent;
+
+/**
+ * Compile-time codec for marshaling values of type T to and from OCP.1.
+ *
+ * Every specialization provides:
+ *  - static constexpr std::size_t Size: the marshaled size, or Ocp1VariableSize.
+ *  - static std::size_t GetSize(const T& value): the marshaled size of the given value.
+ *  - static std::size_t Encode(std::span<std::uint8_t> buffer, const T& value):
+ *      marshals the value to the start of the buffer and returns the number of bytes written,
+ *      or 0 if the buffer is too small or the value cannot be marshaled.
+ *  - static std::size_t Decode(std::span<const std::uint8_t> buffer, T& value):
+ *      unmarshals the value from the start of the buffer and returns the number of bytes read,
+ *      or 0 if the buffer does not hold a complete value.
+ *
+ * Variable size specializations may additionally provide static constexpr std::size_t MinSize,
+ * the smallest marshaled size of any value, see Ocp1MinSize.
+ *
+ * Specializations exist for the OCA base types (integers, floats, bool, std::string,
+ * Ocp1BitStringView),
+ * enumerations (marshaled as their underlying type), std::vector<T> as OcaList<T>,
+ * std::array<T, N> as N consecutive values, Ocp1Position and Ocp1AimingAndPosition.
+ * Further composite types can be added with Ocp1CompositeCodec.
+ */
+template <typename T>
+struct Ocp1Codec;
+
+/**
+ * Lower bound of the marshaled size of any value of type T. Used to reject element counts
+ * a buffer cannot possibly hold before allocating for them. Variable size codecs without
+ * MinSize are assumed to take at least a single byte.
+ */
+template <typename T>
+constexpr std::size_t Ocp1MinSize() noexcept
+{
+    if constexpr (Ocp1Codec<T>::Size != Ocp1VariableSize)
+        return Ocp1Codec<T>::Size;
+    else if constexpr (requires { Ocp1Codec<T>::MinSize; })
+        return Ocp1Codec<T>::MinSize;
+    else
+        return 1;
+}
+
+
+//==============================================================================
+template <typename T>
+    requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+struct Ocp1Codec<T>
+{
+    static constexpr std::size_t Size = sizeof(T);
+
+    static constexpr std::size_t GetSize(const T&) noexcept
+    {
+        return Size;
+    }
+
+    static constexpr std::size_t Encode(std::span<std::uint8_t> buffer, const T& value) noexcept
+    {
+        if (buffer.size() < Size)
+            return 0;
+
+        StoreBigEndian(buffer.data(), value);
+        return Size;
+    }
+
+    static constexpr std::size_t Decode(std::span<const std::uint8_t> buffer, T& value) noexcept
+    {
+        if (buffer.size() < Size)
+            return 0;
+
+        value = LoadBigEndian<T>(buffer.data());
+        return Size;
+    }
+};
+
+template <>
+struct Ocp1Codec<bool>
+{
+    static constexpr std::size_t Size = 1;
+
+    static constexpr std::size_t GetSize(const bool&) noexcept
+    {
+        return Size;
+    }
+
+    static constexpr std::size_t Encode(std::span<std::uint8_t> buffer, const bool& value) noexcept
+    {
+        if (buffer.empty())
+            return 0;
+
+        buffer[0] = value ? 1 : 0;
+        return Size;
+    }
+
+    static constexpr std::size_t Decode(std::span<const std::uint8_t> buffer, bool& value) noexcept
+    {
+        if (buffer.empty())
+            return 0;
+
+        value = (buffer[0] == 1);
+        return Size;
+    }
+};
+
+template <typename T>
+    requires std::is_enum_v<T>
+struct Ocp1Codec<T>
+{
+    using UnderlyingCodec = Ocp1Codec<std::underlying_type_t<T>>;
+
+    static constexpr std::size_t Size = UnderlyingCodec::Size;
+
+    static constexpr std::size_t GetSize(const T&) noexcept
+    {
+        return Size;
+    }
+
+    static constexpr std::size_t Encode(std::span<std::uint8_t> buffer, const T& value) noexcept
+    {
+        return UnderlyingCodec::Encode(buffer, static_cast<std::underlying_type_t<T>>(value));
+    }
+
+    static constexpr std::size_t Decode(std::span<const std::uint8_t> buffer, T& value) noexcept
+    {
+        std::underlying_type_t<T> underlying{};
+        auto size = UnderlyingCodec::Decode(buffer, underlying);
+        if (size > 0)
+            value = static_cast<T>(underlying);
+
+        return size;
+    }
+};
+
+/**
+ * OcaString: 16-bit length followed by the characters.
+ * Like DataFromString, the length counts bytes, which equals the OCA character count for ASCII.
+ */
+template <>
+struct Ocp1Codec<std::string>
+{
+    static constexpr std::size_t Size = Ocp1VariableSize;
+    static constexpr std::size_t MinSize = sizeof(std::uint16_t);
+
+    static std::size_t GetSize(const std::string& value) noexcept
+    {
+        return sizeof(std::uint16_t) + value.size();
+    }
+
+    static std::size_t Encode(std::span<std::uint8_t> buffer, const std::string& value) noexcept
+    {
+        auto size = GetSize(value);
+        if (value.size() > 0xffff || buffer.size() < size)
+            return 0;
+
+        StoreBigEndian(buffer.data(), static_cast<std::uint16_t>(value.size()));
+        if (!value.empty())
+            std::memcpy(buffer.data() + sizeof(std::uint16_t), value.data(), value.size());
+
+        return size;
+    }
+
+    static std::size_t Decode(std::span<const std::uint8_t> buffer, std::string& value)
+    {
+        if (buffer.size() < sizeof(std::uint16_t))
+            return 0;
+
+        auto length = LoadBigEndian<std::uint16_t>(buffer.data());
+        if (buffer.size() < sizeof(std::uint16_t) + length)
+            return 0;
+
+        value.assign(reinterpret_cast<const char*>(buffer.data() + sizeof(std::uint16_t)), length);
+        return sizeof(std::uint16_t) + length;
+    }
+};
+
+
+/**
+ * OcaBitString, decoded zero-copy into a view of the given buffer.
+ */
+template <>
+struct Ocp1Codec<Ocp1BitStringView>
+{
+    static constexpr std::size_t Size = Ocp1VariableSize;
+    static constexpr std::size_t MinSize = sizeof(std::uint16_t);
+
+    static std::size_t GetSize(const Ocp1BitStringView& value) noexcept
+    {
+        return sizeof(std::uint16_t) + value.bytes().size();
+    }
+
+    static std::size_t Encode(std::span<std::uint8_t> buffer, const Ocp1BitStringView& value) noexcept
+    {
+        auto size = GetSize(value);
+        if (value.size() > 0xffff || buffer.size() < size)
+            return 0;
+
+        StoreBigEndian(buffer.data(), static_cast<std::uint16_t>(value.size()));
+        if (value.empty())
+            return size;
+
+        std::memcpy(buffer.data() + sizeof(std::uint16_t), value.bytes().data(), value.bytes().size());
+
+        // Clear the padding bits of the last byte.
+        if (auto validBitsInLastByte = value.size() % 8; validBitsInLastByte != 0)
+            buffer[size - 1] &= static_cast<std::uint8_t>(0xff << (8 - validBitsInLastByte));
+
+        return size;
+    }
+
+    static std::size_t Decode(std::span<const std::uint8_t> buffer, Ocp1BitStringView& value) noexcept
+    {
+        if (buffer.size() < sizeof(std::uint16_t))
+            return 0;
+
+        auto bitCount = LoadBigEndian<std::uint16_t>(buffer.data());
+        auto byteCount = (static_cast<std::size_t>(bitCount) + 7) / 8;
+        if (buffer.size() < sizeof(std::uint16_t) + byteCount)
+            return 0;
+
+        value = Ocp1BitStringView(buffer.subspan(sizeof(std::uint16_t), byteCount), bitCount);
+        return sizeof(std::uint16_t) + byteCount;
+    }
+};
+
+
+//==============================================================================
+/**
+ * Sequence helpers shared by the OcaList and std::array codecs. Arithmetic elements
+ * are converted in bulk by the kernels of Ocp1ByteOrder.h, everything else one by one.
+ */
+struct Ocp1SequenceCodec
+{
+    template <typename T>
+    static constexpr bool IsBulk = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    template <typename Sequence>
+    static std::size_t GetElementsSize(const Sequence& values)
+    {
+        using ElementCodec = Ocp1Codec<typename Sequence::value_type>;
+
+        if constexpr (ElementCodec::Size != Ocp1VariableSize)
+        {
+            return values.size() * ElementCodec::Size;
+        }
+        else
+        {
+            std::size_t size = 0;
+            for (const auto& value : values)
+                size += ElementCodec::GetSize(value);
+
+            return size;
+        }
+    }
+
+    template <typename Sequence>
+    static std::size_t EncodeElements(std::span<std::uint8_t> buffer, const Sequence& values)
+    {
+        using Element = typename Sequence::value_type;
+
+        if constexpr (IsBulk<Element>)
+        {
+            auto size = values.size() * sizeof(Element);
+            if (buffer.size() < size)
+                return 0;
+
+            if constexpr (sizeof(Element) == 1)
+                std::memcpy(buffer.data(), values.data(), size);
+            else
+                StoreBigEndianArray(buffer.data(), values.data(), values.size());
+
+            return size;
+        }
+        else
+        {
+            std::size_t pos = 0;
+            for (const auto& value : values)
+            {
+                auto size = Ocp1Codec<Element>::Encode(buffer.subspan(pos), value);
+                if (size == 0)
+                    return 0;
+
+                pos += size;
+            }
+
+            return pos;
+        }
+    }
+
+    /**
+     * Decodes values.size() elements into the already sized sequence.
+     */
+    template <typename Sequence>
+    static std::size_t DecodeElements(std::span<const std::uint8_t> buffer, Sequence& values)
+    {
+        using Element = typename Sequence::value_type;
+
+        if constexpr (IsBulk<Element>)
+        {
+            auto size = values.size() * sizeof(Element);
+            if (buffer.size() < size)
+                return 0;
+
+            if constexpr (sizeof(Element) == 1)
+                std::memcpy(values.data(), buffer.data(), size);
+            else
+                LoadBigEndianArray(buffer.data(), values.data(), values.size());
+
+            return size;
+        }
+        else
+        {
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < values.size(); i++)
+            {
+                Element value{};
+                auto size = Ocp1Codec<Element>::Decode(buffer.subspan(pos), value);
+                if (size == 0)
+                    return 0;
+
+                values[i] = std::move(value);
+                pos += size;
+            }
+
+            return pos;
+        }
+    }
+};
+
+/**
+ * OcaList<T>: 16-bit element count followed by the elements.
+ * std::vector<std::uint8_t> thereby also covers OcaBlob.
+ */
+template <typename T>
+struct Ocp1Codec<std::vector<T>>
+{
+    static constexpr std::size_t Size = Ocp1VariableSize;
+    static constexpr std::size_t MinSize = sizeof(std::uint16_t);
+
+    static std::size_t GetSize(const std::vector<T>& value)
+    {
+        return sizeof(std::uint16_t) + Ocp1SequenceCodec::GetElementsSize(value);
+    }
+
+    static std::size_t Encode(std::span<std::uint8_t> buffer, const std::vector<T>& value)
+    {
+        if (value.size() > 0xffff || buffer.size() < sizeof(std::uint16_t))
+            return 0;
+
+        StoreBigEndian(buffer.data(), static_cast<std::uint16_t>(value.size()));
+        if (value.empty())
+            return sizeof(std::uint16_t);
+
+        auto size = Ocp1SequenceCodec::EncodeElements(buffer.subspan(sizeof(std::uint16_t)), value);
+        return size > 0 ? sizeof(std::uint16_t) + size : 0;
+    }
+
+    static std::size_t Decode(std::span<const std::uint8_t> buffer, std::vector<T>& value)
+    {
+        if (buffer.size() < sizeof(std::uint16_t))
+            return 0;
+
+        auto count = LoadBigEndian<std::uint16_t>(buffer.data());
+
+        // Reject counts the buffer cannot possibly hold before allocating for them,
+        // also for variable size elements, e.g. every OcaString takes at least its length field.
+        if (buffer.size() < sizeof(std::uint16_t) + count * Ocp1MinSize<T>())
+            return 0;
+
+        value.clear();
+        value.resize(count);
+        if (count == 0)
+            return sizeof(std::uint16_t);
+
+        auto size = Ocp1SequenceCodec::DecodeElements(buffer.subspan(sizeof(std::uint16_t)), value);
+        return size > 0 ? sizeof(std::uint16_t) + size : 0;
+    }
+};
+
+/**
+ * N consecutive values without a count, e.g. OcaBlobFixedLen<N> as std::array<std::uint8_t, N>.
+ */
+template <typename T, std::size_t N>
+struct Ocp1Codec<std::array<T, N>>
+{
+    static_assert(N > 0, "Empty arrays have no marshaled representation");
+
+    static constexpr std::size_t Size = Ocp1Codec<T>::Size != Ocp1VariableSize ? N * Ocp1Codec<T>::Size : Ocp1VariableSize;
+    static constexpr std::size_t MinSize = N * Ocp1MinSize<T>();
+
+    static std::size_t GetSize(const std::array<T, N>& value)
+    {
+        return Ocp1SequenceCodec::GetElementsSize(value);
+    }
+
+    static std::size_t Encode(std::span<std::uint8_t> buffer, const std::array<T, N>& value)
+    {
+        return Ocp1SequenceCodec::EncodeElements(buffer, value);
+    }
+
+    static std::size_t Decode(std::span<const std::uint8_t> buffer, std::array<T, N>& value)
+    {
+        return Ocp1SequenceCodec::DecodeElements(buffer, value);
+    }
+};
+
+
+//==============================================================================
+/**
+ * Generic codec for structs marshaled as the concatenation of some of their members.
+ * Specialize Ocp1Codec for the struct by deriving from this with the member pointers
+ * in marshaling order, e.g.
+ *
+ *     template <>
+ *     struct Ocp1Codec<MyRange> : Ocp1CompositeCodec<MyRange, &MyRange::m_min, &MyRange::m_max> {};
+ *
+ * If all members have a fixed size, so does the struct, and encoding and decoding compile
+ * down to a single size check followed by straight-line loads or stores.
+ */
+template <typename T, auto... Members>
+struct Ocp1CompositeCodec
+{
+private:
+    template <auto Member>
+    struct MemberTraits;
+
+    template <typename Class, typename Member, Member Class::* Pointer>
+    struct MemberTraits<Pointer>
+    {
+        using Type = Member;
+    };
+
+    template <auto Member>
+    using MemberCodec = Ocp1Codec<typename MemberTraits<Member>::Type>;
+
+    static constexpr bool IsFixedSize = ((MemberCodec<Members>::Size != Ocp1VariableSize) && ...);
+
+public:
+    static constexpr std::size_t Size = IsFixedSize ? (MemberCodec<Members>::Size + ...) : Ocp1VariableSize;
+    static constexpr std::size_t MinSize = (Ocp1MinSize<typename MemberTraits<Members>::Type>() + ...);
+
+    static std::size_t GetSize(const T& value)
+    {
+        if constexpr (IsFixedSize)
+            return Size;
+        else
+            return (MemberCodec<Members>::GetSize(value.*Members) + ...);
+    }
+
+    static std::size_t Encode(std::span<std::uint8_t> buffer, const T& value)
+    {
+        if constexpr (IsFixedSize)
+            if (buffer.size() < Size)
+                return 0;
+
+        std::size_t pos = 0;
+        auto encodeMember = [&](auto member, const auto& memberValue)
+        {
+            auto size = MemberCodec<decltype(member)::value>::Encode(buffer.subspan(pos), memberValue);
+            pos += size;
+            return size > 0;
+        };
+
+        if (!(encodeMember(std::integral_constant<decltype(Members), Members>{}, value.*Members) && ...))
+            return 0;
+
+        return pos;
+    }
+
+    static std::size_t Decode(std::span<const std::uint8_t> buffer, T& value)
+    {
+        if constexpr (IsFixedSize)
+            if (buffer.size() < Size)
+                return 0;
+
+        std::size_t pos = 0;
+        auto decodeMember = [&](auto member, auto& memberValue)
+        {
+            auto size = MemberCodec<decltype(member)::value>::Decode(buffer.subspan(pos), memberValue);
+            pos += size;
+            return size > 0;
+        };
+
+        if (!(decodeMember(std::integral_constant<decltype(Members), Members>{}, value.*Members) && ...))
+            return 0;
+
+        return pos;
+    }
+};
+
+template <>
+struct Ocp1Codec<Ocp1Position>
+    : Ocp1CompositeCodec<Ocp1Position, &Ocp1Position::m_x, &Ocp1Position::m_y, &Ocp1Position::m_z> {};
+
+template <>
+struct Ocp1Codec<Ocp1AimingAndPosition>
+    : Ocp1CompositeCodec<Ocp1AimingAndPosition,
+                         &Ocp1AimingAndPosition::m_hor, &Ocp1AimingAndPosition::m_vert, &Ocp1AimingAndPosition::m_rot,
+                         &Ocp1AimingAndPosition::m_x, &Ocp1AimingAndPosition::m_y, &Ocp1AimingAndPosition::m_z> {};
+
+
+//==============================================================================
+/**
+ * Generic counterpart of the DataToX methods: unmarshals a value from the start of the
+ * given parameter data. Like DataToInt32, trailing bytes (e.g. min and max values) are ignored.
+ *
+ * @param[in] parameterData     Bytes containing the value.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value, or a default constructed one on failure.
+ */
+template <typename T>
+T DataTo(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr)
+{
+    T ret{};
+    bool ok = (Ocp1Codec<T>::Decode(parameterData, ret) > 0);
+    if (!ok)
+        ret = T{};
+
+    if (pOk != nullptr)
+        *pOk = ok;
+
+    return ret;
+}
+
+/**
+ * Generic counterpart of the DataFromX methods: marshals a value into a new byte vector.
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector, empty if it cannot be marshaled.
+ */
+template <typename T>
+ByteVector DataFrom(const T& value)
+{
+    ByteVector ret(Ocp1Codec<T>::GetSize(value));
+    if (Ocp1Codec<T>::Encode(ret, value) == 0)
+        ret.clear();
+
+    return ret;
+}
+
+/**
+ * Unmarshals several consecutive values, e.g. a value followed by its min and max,
+ * or all parameters of a response, from the start of the given parameter data.
+ *
+ * @param[in] parameterData     Bytes containing the values.
+ * @param[out] values           Values to unmarshal, in marshaling order.
+ * @return  True if all values were complete.
+ */
+template <typename... T>
+bool DataToValues(std::span<const std::uint8_t> parameterData, T&... values)
+{
+    std::size_t pos = 0;
+    auto decodeValue = [&](auto& value)
+    {
+        auto size = Ocp1Codec<std::remove_reference_t<decltype(value)>>::Decode(parameterData.subspan(pos), value);
+        pos += size;
+        return size > 0;
+    };
+
+    return (decodeValue(values) && ...);
+}
+
+}
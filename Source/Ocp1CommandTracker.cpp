@@ -0,0 +1,145 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1CommandTracker.h"
+#include "Ocp1Message.h"
+#include "Ocp1Metrics.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1CommandTracker::Ocp1CommandTracker(Ocp1Metrics* metrics)
+    : m_metrics(metrics)
+{
+}
+
+Ocp1CommandTracker::~Ocp1CommandTracker()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void Ocp1CommandTracker::track(std::uint32_t handle, const ResponseCallback& callback, int timeoutMs)
+{
+    {
+        const juce::ScopedLock sl(m_trackedLock);
+        m_trackedCommands[handle] = { callback, juce::Time::getMillisecondCounterHiRes() + timeoutMs };
+    }
+
+    if (!isTimerRunning())
+        startTimer(50);
+}
+
+void Ocp1CommandTracker::untrack(std::uint32_t handle)
+{
+    const juce::ScopedLock sl(m_trackedLock);
+    m_trackedCommands.erase(handle);
+}
+
+bool Ocp1CommandTracker::processReceivedData(const ByteVector& data)
+{
+    constexpr std::size_t msgTypeOffset = 7;
+    constexpr std::size_t handleOffset = Ocp1Header::Ocp1HeaderSize + 4; // After response size.
+
+    // Peek at the raw data first, to not unmarshal messages nobody here is waiting for.
+    if (data.size() < handleOffset + 4 || data[msgTypeOffset] != Ocp1Message::Response)
+        return false;
+
+    ResponseCallback callback;
+    {
+        const juce::ScopedLock sl(m_trackedLock);
+
+        auto iter = m_trackedCommands.find(ReadUint32(data.data() + handleOffset));
+        if (iter == m_trackedCommands.end())
+            return false;
+
+        callback = std::move(iter->second.m_callback);
+        m_trackedCommands.erase(iter);
+    }
+
+    // Framing errors were already counted by the reader thread.
+    auto msgObj = Ocp1Message::UnmarshalOcp1Message(data);
+    if (callback)
+        callback(msgObj ? static_cast<Ocp1Response*>(msgObj.get()) : nullptr);
+
+    return true;
+}
+
+void Ocp1CommandTracker::failAll()
+{
+    std::map<std::uint32_t, TrackedCommand> failedCommands;
+    {
+        const juce::ScopedLock sl(m_trackedLock);
+        failedCommands.swap(m_trackedCommands);
+    }
+
+    for (auto& failedCommand : failedCommands)
+        if (failedCommand.second.m_callback)
+            failedCommand.second.m_callback(nullptr);
+}
+
+std::size_t Ocp1CommandTracker::getTrackedCount() const
+{
+    const juce::ScopedLock sl(m_trackedLock);
+    return m_trackedCommands.size();
+}
+
+std::uint64_t Ocp1CommandTracker::getTimeoutCount() const
+{
+    return m_timeoutCount;
+}
+
+//==============================================================================
+void Ocp1CommandTracker::timerCallback()
+{
+    auto nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    std::vector<ResponseCallback> timedOutCallbacks;
+    {
+        const juce::ScopedLock sl(m_trackedLock);
+
+        for (auto iter = m_trackedCommands.begin(); iter != m_trackedCommands.end();)
+        {
+            if (iter->second.m_deadlineMs <= nowMs)
+            {
+                timedOutCallbacks.push_back(std::move(iter->second.m_callback));
+                iter = m_trackedCommands.erase(iter);
+            }
+            else
+                iter++;
+        }
+
+        if (m_trackedCommands.empty())
+            stopTimer();
+    }
+
+    m_timeoutCount += timedOutCallbacks.size();
+    if (m_metrics != nullptr && !timedOutCallbacks.empty())
+        m_metrics->add(Ocp1Metrics::Counter::CommandTimeouts, static_cast<std::int64_t>(timedOutCallbacks.size()));
+
+    // Callbacks are invoked outside the lock, since they may well track new commands.
+    for (auto& callback : timedOutCallbacks)
+        if (callback)
+            callback(nullptr);
+}
+
+
+}
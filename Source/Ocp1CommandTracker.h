@@ -0,0 +1,110 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+    #include <juce_events/juce_events.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1Metrics;
+class Ocp1Response;
+
+
+//==============================================================================
+/**
+    Keeps track of sent commands that are waiting for their Ocp1Response.
+
+    Each tracked command is identified by its handle and carries a callback and a deadline.
+    The callback is invoked exactly once: with the matching response when it arrives
+    (on the thread that delivers received data), or with nullptr when the deadline passed
+    or the tracked commands are failed because the connection was lost.
+*/
+class Ocp1CommandTracker : private juce::Timer
+{
+public:
+    using ResponseCallback = std::function<void(const Ocp1Response* response)>;
+
+public:
+    //==============================================================================
+    Ocp1CommandTracker(Ocp1Metrics* metrics = nullptr);
+    ~Ocp1CommandTracker() override;
+
+    //==============================================================================
+    /**
+     * Starts tracking the command with the given handle.
+     *
+     * @param[in] handle        Handle of the sent command.
+     * @param[in] callback      Callback to invoke with the response, or nullptr on timeout.
+     * @param[in] timeoutMs     Time to wait for the response before giving up.
+     */
+    void track(std::uint32_t handle, const ResponseCallback& callback, int timeoutMs);
+
+    /**
+     * Stops tracking the command with the given handle without invoking its callback.
+     */
+    void untrack(std::uint32_t handle);
+
+    /**
+     * Checks whether the given serialized message is a response to a tracked command.
+     * If so, the message is unmarshaled, passed to the command's callback and tracking ends.
+     *
+     * @param[in] data  Serialized OCA message as received.
+     * @return  True if the message was consumed.
+     */
+    bool processReceivedData(const ByteVector& data);
+
+    /**
+     * Invokes the callbacks of all tracked commands with nullptr and stops tracking them.
+     */
+    void failAll();
+
+    std::size_t getTrackedCount() const;
+    std::uint64_t getTimeoutCount() const;
+
+private:
+    //==============================================================================
+    void timerCallback() override;
+
+    //==============================================================================
+    struct TrackedCommand
+    {
+        ResponseCallback    m_callback;     // Callback to invoke once.
+        double              m_deadlineMs;   // Millisecond counter value after which the command is timed out.
+    };
+
+    //==============================================================================
+    juce::CriticalSection                       m_trackedLock;
+    std::map<std::uint32_t, TrackedCommand>     m_trackedCommands;
+
+    std::atomic<std::uint64_t>                  m_timeoutCount{ 0 };
+    Ocp1Metrics*                                m_metrics{ nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1CommandTracker)
+};
+
+}
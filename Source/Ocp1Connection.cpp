@@ -80,10 +80,15 @@ class Ocp1Connection::SafeAction : public SafeActionImpl
 
 //==============================================================================
 Ocp1Connection::Ocp1Connection(bool callbacksOnMessageThread , const juce::Thread::Priority threadPriority)
-    : useMessageThread(callbacksOnMessageThread),
+    : useMessageThread(callbacksOnMessageThread), metrics(std::make_shared<Ocp1Metrics>()),
+    wireCapture(std::make_unique<Ocp1WireCapture>()),
     safeAction(std::make_shared<SafeAction>(*this)), m_threadPriority(threadPriority)
 {
     thread.reset(new ConnectionThread(*this));
+
+   #if NANOOCP1_PIPELINE_TIMESTAMPS
+    pipelineStats = std::make_shared<Ocp1PipelineStats>();
+   #endif
 }
 
 Ocp1Connection::~Ocp1Connection()
@@ -170,7 +175,29 @@ juce::String Ocp1Connection::getConnectedHostName() const
 //==============================================================================
 bool Ocp1Connection::sendMessage(const ByteVector& message)
 {
-    return writeData(const_cast<std::uint8_t*>(message.data()), static_cast<int>(message.size())) == message.size();
+    wireCapture->capture(Ocp1WireCapture::Direction::Sent, message);
+
+    auto bytesWritten = writeData(const_cast<std::uint8_t*>(message.data()), static_cast<int>(message.size()));
+    if (bytesWritten > 0)
+        metrics->add(Ocp1Metrics::Counter::BytesOut, bytesWritten);
+
+    if (bytesWritten != static_cast<int>(message.size()))
+        return false;
+
+    metrics->add(Ocp1Metrics::Counter::PdusOut);
+    return true;
+}
+
+void Ocp1Connection::setReceiveTimeout(int timeoutMs)
+{
+    // Don't count the time without supervision.
+    lastReceiveMs = juce::Time::getMillisecondCounterHiRes();
+    receiveTimeoutMs = juce::jmax(0, timeoutMs);
+}
+
+int Ocp1Connection::getReceiveTimeout() const
+{
+    return receiveTimeoutMs;
 }
 
 int Ocp1Connection::writeData(void* data, int dataSize)
@@ -188,6 +215,7 @@ void Ocp1Connection::initialise()
 {
     safeAction->setSafe(true);
     threadIsRunning = true;
+    lastReceiveMs = juce::Time::getMillisecondCounterHiRes();
     connectionMadeInt();
     thread->startThread(m_threadPriority);
 }
@@ -228,6 +256,7 @@ void Ocp1Connection::connectionMadeInt()
     if (!callbackConnectionState)
     {
         callbackConnectionState = true;
+        metrics->add(Ocp1Metrics::Counter::ConnectionsMade);
 
         if (useMessageThread)
             (new ConnectionStateMessage(safeAction, true))->post();
@@ -241,6 +270,7 @@ void Ocp1Connection::connectionLostInt()
     if (callbackConnectionState)
     {
         callbackConnectionState = false;
+        metrics->add(Ocp1Metrics::Counter::ConnectionsLost);
 
         if (useMessageThread)
             (new ConnectionStateMessage(safeAction, false))->post();
@@ -251,19 +281,45 @@ void Ocp1Connection::connectionLostInt()
 
 struct DataDeliveryMessage : public juce::Message
 {
-    DataDeliveryMessage(std::shared_ptr<SafeActionImpl> ipc, const ByteVector& d)
-        : safeAction(ipc), data(d)
-    {}
+    DataDeliveryMessage(std::shared_ptr<SafeActionImpl> ipc, std::shared_ptr<Ocp1Metrics> m, const ByteVector& d)
+        : safeAction(ipc), metrics(m), data(d)
+    {
+        metrics->add(Ocp1Metrics::Counter::DeliveryQueueDepth);
+    }
+
+    ~DataDeliveryMessage() override
+    {
+        metrics->add(Ocp1Metrics::Counter::DeliveryQueueDepth, -1);
+    }
 
     void messageCallback() override
     {
         safeAction->ifSafe([this](Ocp1Connection& owner)
             {
+               #if NANOOCP1_PIPELINE_TIMESTAMPS
+                Deliver(owner, data, timestamps);
+               #else
                 owner.messageReceived(data);
+               #endif
             });
     }
 
+   #if NANOOCP1_PIPELINE_TIMESTAMPS
+    static void Deliver(Ocp1Connection& owner, const ByteVector& data, Ocp1PipelineTimestamps& timestamps)
+    {
+        timestamps.stamp(Ocp1PipelineTimestamps::CallbackEntered);
+        owner.pipelineStats->record(timestamps);
+
+        owner.currentTimestamps = &timestamps;
+        owner.messageReceived(data);
+        owner.currentTimestamps = nullptr;
+    }
+
+    Ocp1PipelineTimestamps timestamps;
+   #endif
+
     std::shared_ptr<SafeActionImpl> safeAction;
+    std::shared_ptr<Ocp1Metrics> metrics;
     ByteVector data;
 };
 
@@ -271,10 +327,23 @@ void Ocp1Connection::deliverDataInt(const ByteVector& data)
 {
     jassert(callbackConnectionState);
 
+   #if NANOOCP1_PIPELINE_TIMESTAMPS
+    pendingTimestamps.stamp(Ocp1PipelineTimestamps::Enqueued);
+
+    if (useMessageThread)
+    {
+        auto* message = new DataDeliveryMessage(safeAction, metrics, data);
+        message->timestamps = pendingTimestamps;
+        message->post();
+    }
+    else
+        DataDeliveryMessage::Deliver(*this, data, pendingTimestamps);
+   #else
     if (useMessageThread)
-        (new DataDeliveryMessage(safeAction, data))->post();
+        (new DataDeliveryMessage(safeAction, metrics, data))->post();
     else
         messageReceived(data);
+   #endif
 }
 
 //==============================================================================
@@ -299,6 +368,8 @@ bool Ocp1Connection::readNextMessage()
     {
         // Unmarshal the OCA header using a Ocp1Header helper object.
         Ocp1Header tmpHeader(messageData);
+        if (!tmpHeader.IsValid())
+            metrics->decodeFailed(Ocp1Metrics::DecodeFailure::InvalidHeader);
 
         // Resize the MemoryBlock to fit the complete OCA message.
         // NOTE: msgSize does not include the sync byte.
@@ -321,7 +392,32 @@ bool Ocp1Connection::readNextMessage()
             bytesLeft -= bytesIn;
         }
 
-        deliverDataInt(messageData);
+        lastReceiveMs = juce::Time::getMillisecondCounterHiRes();
+
+        wireCapture->capture(Ocp1WireCapture::Direction::Received, messageData.data(), static_cast<std::size_t>(readPosition));
+
+        metrics->add(Ocp1Metrics::Counter::BytesIn, readPosition);
+        metrics->add(Ocp1Metrics::Counter::PdusIn);
+        if (!tmpHeader.IsValid())
+            wireCapture->requestErrorDump("invalid_header");
+        else if (bytesLeft > 0)
+        {
+            metrics->decodeFailed(Ocp1Metrics::DecodeFailure::Truncated);
+            wireCapture->requestErrorDump("truncated");
+        }
+
+       #if NANOOCP1_PIPELINE_TIMESTAMPS
+        pendingTimestamps.stamp(Ocp1PipelineTimestamps::PduComplete);
+       #endif
+
+        auto consumed = preprocessMessage(messageData);
+
+       #if NANOOCP1_PIPELINE_TIMESTAMPS
+        pendingTimestamps.stamp(Ocp1PipelineTimestamps::Preprocessed);
+       #endif
+
+        if (!consumed)
+            deliverDataInt(messageData);
 
         return true;
     }
@@ -337,6 +433,12 @@ bool Ocp1Connection::readNextMessage()
     return false;
 }
 
+bool Ocp1Connection::hasReceiveTimedOut() const
+{
+    auto timeoutMs = receiveTimeoutMs.load();
+    return timeoutMs > 0 && juce::Time::getMillisecondCounterHiRes() - lastReceiveMs.load() > timeoutMs;
+}
+
 void Ocp1Connection::runThread()
 {
     while (!thread->threadShouldExit())
@@ -352,8 +454,26 @@ void Ocp1Connection::runThread()
                 break;
             }
 
+           #if NANOOCP1_PIPELINE_TIMESTAMPS
+            if (ready > 0)
+            {
+                pendingTimestamps = {};
+                pendingTimestamps.stamp(Ocp1PipelineTimestamps::SocketReadable);
+            }
+           #endif
+
             if (ready == 0)
             {
+                // A peer that lost power does not close the connection, it just goes silent.
+                if (hasReceiveTimedOut())
+                {
+                    metrics->add(Ocp1Metrics::Counter::ReceiveTimeouts);
+                    wireCapture->requestErrorDump("receive_timeout");
+                    deleteSocket();
+                    connectionLostInt();
+                    break;
+                }
+
                 thread->wait(1);
                 continue;
             }
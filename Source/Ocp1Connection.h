@@ -25,6 +25,9 @@
 #endif
 
 #include "Ocp1DataTypes.h"
+#include "Ocp1Metrics.h"
+#include "Ocp1PipelineTimestamps.h"
+#include "Ocp1WireCapture.h"
 
 
 namespace NanoOcp1
@@ -56,11 +59,39 @@ public:
     juce::String getConnectedHostName() const;
     bool sendMessage(const ByteVector& message);
 
+    /** Sets the time after which the connection is considered lost if nothing was received.
+        The reader thread then closes the socket and reports the lost connection. 0 disables the supervision.
+    */
+    void setReceiveTimeout(int timeoutMs);
+    int getReceiveTimeout() const;
+
+    /** Transport counters of this connection. */
+    Ocp1Metrics& getMetrics() const noexcept { return *metrics; }
+
+    /** Raw messages recently sent and received on this connection. Dumped automatically on
+        invalid or truncated messages and receive timeouts, if an error dump directory is set.
+    */
+    Ocp1WireCapture& getWireCapture() const noexcept { return *wireCapture; }
+
+   #if NANOOCP1_PIPELINE_TIMESTAMPS
+    /** Pipeline timestamps of the message currently being delivered. Only valid within messageReceived. */
+    const Ocp1PipelineTimestamps* getCurrentMessageTimestamps() const noexcept { return currentTimestamps; }
+
+    /** Histograms of the time received messages spent in the receive pipeline. */
+    Ocp1PipelineStats& getPipelineStats() const noexcept { return *pipelineStats; }
+   #endif
+
     //==============================================================================
     virtual void connectionMade() = 0;
     virtual void connectionLost() = 0;
     virtual void messageReceived(const ByteVector& message) = 0;
 
+    /**
+     * Called on the reader thread for every received message, before it is delivered via messageReceived.
+     * Returning true consumes the message, it is then not delivered at all.
+     */
+    virtual bool preprocessMessage(const ByteVector& message) { juce::ignoreUnused(message); return false; }
+
 private:
     //==============================================================================
     juce::ReadWriteLock socketLock;
@@ -75,12 +106,24 @@ private:
     void connectionMadeInt();
     void connectionLostInt();
     void deliverDataInt(const ByteVector&);
+    friend struct DataDeliveryMessage;
     bool readNextMessage();
+    bool hasReceiveTimedOut() const;
     int readData(void*, int);
 
     struct ConnectionThread;
     std::unique_ptr<ConnectionThread> thread;
     std::atomic<bool> threadIsRunning{ false };
+    std::atomic<int> receiveTimeoutMs{ 0 };
+    std::atomic<double> lastReceiveMs{ 0.0 };
+    std::shared_ptr<Ocp1Metrics> metrics;   // Shared with posted messages, which might outlive the connection.
+    std::unique_ptr<Ocp1WireCapture> wireCapture;
+
+   #if NANOOCP1_PIPELINE_TIMESTAMPS
+    Ocp1PipelineTimestamps pendingTimestamps;           // Message currently read, reader thread only.
+    const Ocp1PipelineTimestamps* currentTimestamps = nullptr;
+    std::shared_ptr<Ocp1PipelineStats> pipelineStats;   // Shared with posted messages, like metrics.
+   #endif
 
     class SafeAction;
     std::shared_ptr<SafeAction> safeAction;
@@ -74,7 +74,10 @@ void Ocp1ConnectionServer::run()
 
         if (clientSocket != nullptr)
             if (auto* newConnection = createConnectionObject())
+            {
+                newConnection->getMetrics().add(Ocp1Metrics::Counter::ConnectionsAccepted);
                 newConnection->initialiseWithSocket(std::move(clientSocket));
+            }
     }
 }
 
@@ -24,19 +24,12 @@
 
 
 #include "Ocp1DataTypes.h"
+#include "Ocp1Codec.h"
 
 namespace NanoOcp1
 {
 
-static constexpr std::uint8_t uint8_8(8);
-static constexpr std::uint8_t uint8_16(16);
-static constexpr std::uint8_t uint8_24(24);
-static constexpr std::uint8_t uint8_32(32);
-static constexpr std::uint8_t uint8_40(40);
-static constexpr std::uint8_t uint8_48(48);
-static constexpr std::uint8_t uint8_56(56);
-
-bool DataToBool(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+bool DataToBool(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
     bool ret(false);
     bool ok = parameterData.size() == 1;
@@ -59,164 +52,89 @@ std::vector<std::uint8_t> DataFromBool(bool boolValue)
     return std::vector<std::uint8_t>{ boolValue ? static_cast<std::uint8_t>(1) : static_cast<std::uint8_t>(0) };
 }
 
-std::int32_t DataToInt32(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::int8_t DataToInt8(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::int32_t ret(0);
-
-    // HACK: Use >= and not == to easily deal with responses sometimes including min and max values.
-    bool ok = (parameterData.size() >= sizeof(std::int32_t)); // 4 bytes expected.
-    if (ok)
-    {
-        ret = (((parameterData[0] << uint8_24) & 0xff000000) +
-               ((parameterData[1] << uint8_16) & 0x00ff0000) +
-               ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
-    }
+    return DataTo<std::int8_t>(parameterData, pOk);
+}
 
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
+std::vector<std::uint8_t> DataFromInt8(std::int8_t value)
+{
+    return DataFrom(value);
+}
 
-    return ret;
+std::int16_t DataToInt16(std::span<const std::uint8_t> parameterData, bool* pOk)
+{
+    return DataTo<std::int16_t>(parameterData, pOk);
 }
 
-std::vector<std::uint8_t> DataFromInt32(std::int32_t intValue)
+std::vector<std::uint8_t> DataFromInt16(std::int16_t value)
 {
-    std::vector<std::uint8_t> ret;
-    ret.reserve(4);
+    return DataFrom(value);
+}
 
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+std::int32_t DataToInt32(std::span<const std::uint8_t> parameterData, bool* pOk)
+{
+    // HACK: Use >= and not == to easily deal with responses sometimes including min and max values.
+    return DataTo<std::int32_t>(parameterData, pOk); // 4 bytes expected.
+}
 
-    return ret;
+std::vector<std::uint8_t> DataFromInt32(std::int32_t intValue)
+{
+    return DataFrom(intValue);
 }
 
-std::uint8_t DataToUint8(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::int64_t DataToInt64(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::uint8_t ret(0);
-    bool ok = (parameterData.size() >= sizeof(std::uint8_t));
-    if (ok)
-    {
-        ret = parameterData[0];
-    }
+    return DataTo<std::int64_t>(parameterData, pOk);
+}
 
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
+std::vector<std::uint8_t> DataFromInt64(std::int64_t value)
+{
+    return DataFrom(value);
+}
 
-    return ret;
+std::uint8_t DataToUint8(std::span<const std::uint8_t> parameterData, bool* pOk)
+{
+    return DataTo<std::uint8_t>(parameterData, pOk);
 }
 
 std::vector<std::uint8_t> DataFromUint8(std::uint8_t value)
 {
-    std::vector<std::uint8_t> ret;
-    ret.push_back(value);
-
-    return ret;
+    return DataFrom(value);
 }
 
 
-std::uint16_t DataToUint16(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::uint16_t DataToUint16(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::uint16_t ret(0);
-    bool ok = (parameterData.size() >= sizeof(std::uint16_t));
-    if (ok)
-    {
-        for (size_t i = 0; i < sizeof(std::uint16_t); i++)
-        {
-            ret = ((ret << static_cast<std::uint16_t>(8)) & 0xff00) + parameterData[i];
-        }
-    }
-
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
-
-    return ret;
+    return DataTo<std::uint16_t>(parameterData, pOk);
 }
 
 std::vector<std::uint8_t> DataFromUint16(std::uint16_t value)
 {
-    std::vector<std::uint8_t> ret;
-    ret.push_back(static_cast<std::uint8_t>(value >> 8));
-    ret.push_back(static_cast<std::uint8_t>(value));
-
-    return ret;
+    return DataFrom(value);
 }
 
-std::uint32_t DataToUint32(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::uint32_t DataToUint32(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::uint32_t ret(0);
-
-    bool ok = (parameterData.size() >= sizeof(std::uint32_t)); // 4 bytes expected.
-    if (ok)
-    {
-        ret = (((parameterData[0] << uint8_24) & 0xff000000) +
-               ((parameterData[1] << uint8_16) & 0x00ff0000) +
-               ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
-    }
-
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
-
-    return ret;
+    return DataTo<std::uint32_t>(parameterData, pOk);
 }
 
 std::vector<std::uint8_t> DataFromUint32(std::uint32_t intValue)
 {
-    std::vector<std::uint8_t> ret;
-    ret.reserve(4);
-
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    return ret;
+    return DataFrom(intValue);
 }
 
-std::uint64_t DataToUint64(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::uint64_t DataToUint64(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::uint64_t ret(0);
-
-    bool ok = (parameterData.size() >= sizeof(std::uint64_t)); // 8 bytes expected.
-    if (ok)
-    {
-        std::uint64_t tmp;
-        memcpy(&tmp, parameterData.data(), sizeof(juce::uint64));
-        ret = juce::ByteOrder::swapIfLittleEndian<juce::uint64>(tmp);
-    }
-
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
-
-    return ret;
+    return DataTo<std::uint64_t>(parameterData, pOk);
 }
 
 std::vector<std::uint8_t> DataFromUint64(std::uint64_t intValue)
 {
-    return std::vector<std::uint8_t>
-        ({
-            static_cast<std::uint8_t>(intValue >> 56),
-            static_cast<std::uint8_t>(intValue >> 48),
-            static_cast<std::uint8_t>(intValue >> 40),
-            static_cast<std::uint8_t>(intValue >> 32),
-            static_cast<std::uint8_t>(intValue >> 24),
-            static_cast<std::uint8_t>(intValue >> 16),
-            static_cast<std::uint8_t>(intValue >> 8),
-            static_cast<std::uint8_t>(intValue),
-        });
+    return DataFrom(intValue);
 }
 
-std::string DataToString(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::string DataToString(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
     std::string ret;
 
@@ -250,111 +168,48 @@ std::vector<std::uint8_t> DataFromString(const std::string& string)
     return ret;
 }
 
-std::float_t DataToFloat(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::float_t DataToFloat(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::float_t ret(0);
-
-    bool ok = (parameterData.size() >= sizeof(std::float_t)); // 4 bytes expected.
-    ok = ok && (sizeof(int) == sizeof(std::float_t)); // Required for pointer cast to work
-    if (ok)
-    {
-        int intValue = (((parameterData[0] << uint8_24) & 0xff000000) +
-                        ((parameterData[1] << uint8_16) & 0x00ff0000) +
-                        ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
-        ret = *(std::float_t*)&intValue;
-    }
-
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
-
-    return ret;
+    static_assert(sizeof(std::float_t) == sizeof(std::uint32_t), "OCP.1 Float32 requires a 4 byte std::float_t");
+    return DataTo<std::float_t>(parameterData, pOk); // 4 bytes expected.
 }
 
 std::vector<std::uint8_t> DataFromFloat(std::float_t floatValue)
 {
-    std::vector<std::uint8_t> ret;
-    ret.reserve(4);
-
-    jassert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work
-    std::uint32_t intValue = *(std::uint32_t*)&floatValue;
-
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    return ret;
+    return DataFrom(floatValue);
 }
 
-std::double_t DataToDouble(const std::vector<std::uint8_t>& parameterData, bool* pOk)
+std::double_t DataToDouble(std::span<const std::uint8_t> parameterData, bool* pOk)
 {
-    std::double_t ret(0);
-
-    bool ok = (parameterData.size() >= sizeof(std::double_t)); // 8 bytes expected.
-    ok = ok && (sizeof(std::uint64_t) == sizeof(std::double_t)); // Required for pointer cast to work
-    if (ok)
-    {
-        std::uint64_t intValue = (((static_cast<std::uint64_t>(parameterData[0]) << uint8_56) & 0xff00000000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[1]) << uint8_48) & 0x00ff000000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[2]) << uint8_40) & 0x0000ff0000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[3]) << uint8_32) & 0x000000ff00000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[4]) << uint8_24) & 0x00000000ff000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[5]) << uint8_16) & 0x0000000000ff0000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[6]) << uint8_8)  & 0x000000000000ff00ULL) + 
-                                  parameterData[7]);
-        ret = *(std::double_t*)&intValue;
-    }
-
-    if (pOk != nullptr)
-    {
-        *pOk = ok;
-    }
-
-    return ret;
+    static_assert(sizeof(std::double_t) == sizeof(std::uint64_t), "OCP.1 Float64 requires an 8 byte std::double_t");
+    return DataTo<std::double_t>(parameterData, pOk); // 8 bytes expected.
 }
 
 std::vector<std::uint8_t> DataFromDouble(std::double_t doubleValue)
 {
-    jassert(sizeof(std::uint64_t) == sizeof(std::double_t)); // Required for pointer cast to work
-    std::uint64_t intValue = *(std::uint64_t*)&doubleValue;
+    return DataFrom(doubleValue);
+}
+
+std::vector<std::uint8_t> DataFromBitString(const std::vector<bool>& bits)
+{
+    if (bits.size() > 0xffff)
+        return {};
 
-    return std::vector<std::uint8_t>
-        ({ 
-            static_cast<std::uint8_t>(intValue >> 56),
-            static_cast<std::uint8_t>(intValue >> 48),
-            static_cast<std::uint8_t>(intValue >> 40),
-            static_cast<std::uint8_t>(intValue >> 32),
-            static_cast<std::uint8_t>(intValue >> 24),
-            static_cast<std::uint8_t>(intValue >> 16),
-            static_cast<std::uint8_t>(intValue >> 8),
-            static_cast<std::uint8_t>(intValue),
-        });
+    std::vector<std::uint8_t> ret(sizeof(std::uint16_t) + (bits.size() + 7) / 8, 0);
+    StoreBigEndian(ret.data(), static_cast<std::uint16_t>(bits.size()));
+    for (std::size_t i = 0; i < bits.size(); i++)
+        if (bits[i])
+            ret[sizeof(std::uint16_t) + i / 8] |= static_cast<std::uint8_t>(0x80 >> (i % 8));
+
+    return ret;
 }
 
 std::vector<std::uint8_t> DataFromPosition(std::float_t x, std::float_t y, std::float_t z)
 {
-    jassert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast below
-    std::uint32_t xInt = *(std::uint32_t*)&x;
-    std::uint32_t yInt = *(std::uint32_t*)&y;
-    std::uint32_t zInt = *(std::uint32_t*)&z;
-
-    std::vector<std::uint8_t> ret
-    ({
-        static_cast<std::uint8_t>(xInt >> 24),
-        static_cast<std::uint8_t>(xInt >> 16),
-        static_cast<std::uint8_t>(xInt >> 8),
-        static_cast<std::uint8_t>(xInt),
-        static_cast<std::uint8_t>(yInt >> 24),
-        static_cast<std::uint8_t>(yInt >> 16),
-        static_cast<std::uint8_t>(yInt >> 8),
-        static_cast<std::uint8_t>(yInt),
-        static_cast<std::uint8_t>(zInt >> 24),
-        static_cast<std::uint8_t>(zInt >> 16),
-        static_cast<std::uint8_t>(zInt >> 8),
-        static_cast<std::uint8_t>(zInt),
-    });
+    const std::float_t values[] = { x, y, z };
+
+    std::vector<std::uint8_t> ret(sizeof(values));
+    StoreBigEndianArray(ret.data(), values, 3);
 
     return ret;
 }
@@ -366,46 +221,10 @@ std::vector<std::uint8_t> DataFromPositionAndRotation(std::float_t x, std::float
 
 std::vector<std::uint8_t> DataFromAimingAndPosition(std::float_t hor, std::float_t vert, std::float_t rot, std::float_t x, std::float_t y, std::float_t z)
 {
-    std::vector<std::uint8_t> ret;
-    ret.reserve(6 * 4);
-
-    jassert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work
-
-    std::uint32_t intValue = *(std::uint32_t*)&hor;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&vert;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&rot;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&x;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&y;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&z;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+    const std::float_t values[] = { hor, vert, rot, x, y, z };
+
+    std::vector<std::uint8_t> ret(sizeof(values));
+    StoreBigEndianArray(ret.data(), values, 6);
 
     return ret;
 }
@@ -450,58 +269,87 @@ std::vector<std::uint8_t> DataFromOnoForSubscription(std::uint32_t ono, bool add
     return ret;
 }
 
+std::size_t Ocp1BitStringView::count() const noexcept
+{
+    auto packed = bytes();
+    if (packed.empty())
+        return 0;
+
+    std::size_t ret = 0;
+    for (std::size_t i = 0; i + 1 < packed.size(); i++)
+        ret += static_cast<std::size_t>(std::popcount(packed[i]));
+
+    // Padding bits of the last byte do not count.
+    auto validBitsInLastByte = m_bitCount - (packed.size() - 1) * 8;
+    ret += static_cast<std::size_t>(std::popcount(static_cast<std::uint8_t>(packed.back() & (0xff << (8 - validBitsInLastByte)))));
+
+    return ret;
+}
+
+bool Ocp1BitStringView::operator==(const Ocp1BitStringView& other) const noexcept
+{
+    if (m_bitCount != other.m_bitCount)
+        return false;
+
+    for (std::size_t i = 0; i < m_bitCount; i++)
+        if (test(i) != other.test(i))
+            return false;
+
+    return true;
+}
+
 std::string StatusToString(std::uint8_t status)
 {
     std::string result;
 
     switch (status)
     {
-        case 0: // OCASTATUS_OK:
+        case OCASTATUS_OK:
             result = std::string("OK");
             break;
-        case 1: // OCASTATUS_PROTOCOL_VERSION_ERROR:
+        case OCASTATUS_PROTOCOL_VERSION_ERROR:
             result = std::string("ProtocolVersionError");
             break;
-        case 2: // OCASTATUS_DEVICE_ERROR:
+        case OCASTATUS_DEVICE_ERROR:
             result = std::string("DeviceError");
             break;
-        case 3: // OCASTATUS_LOCKED:
+        case OCASTATUS_LOCKED:
             result = std::string("Locked");
             break;
-        case 4: // OCASTATUS_BAD_FORMAT:
+        case OCASTATUS_BAD_FORMAT:
             result = std::string("BadFormat");
             break;
-        case 5: // OCASTATUS_BAD_ONO:
+        case OCASTATUS_BAD_ONO:
             result = std::string("BadONo");
             break;
-        case 6: // OCASTATUS_PARAMETER_ERROR:
+        case OCASTATUS_PARAMETER_ERROR:
             result = std::string("ParameterError");
             break;
-        case 7: // OCASTATUS_PARAMETER_OUT_OF_RANGE:
+        case OCASTATUS_PARAMETER_OUT_OF_RANGE:
             result = std::string("ParameterOutOfRange");
             break;
-        case 8: // OCASTATUS_NOT_IMPLEMENTED:
+        case OCASTATUS_NOT_IMPLEMENTED:
             result = std::string("NotImplemented");
             break;
-        case 9: // OCASTATUS_INVALID_REQUEST:
+        case OCASTATUS_INVALID_REQUEST:
             result = std::string("InvalidRequest");
             break;
-        case 10: // OCASTATUS_PROCESSING_FAILED:
+        case OCASTATUS_PROCESSING_FAILED:
             result = std::string("ProcessingFailed");
             break;
-        case 11: // OCASTATUS_BAD_METHOD:
+        case OCASTATUS_BAD_METHOD:
             result = std::string("BadMethod");
             break;
-        case 12: // OCASTATUS_PARTIALLY_SUCCEEDED:
+        case OCASTATUS_PARTIALLY_SUCCEEDED:
             result = std::string("PartiallySucceeded");
             break;
-        case 13: // OCASTATUS_TIMEOUT:
+        case OCASTATUS_TIMEOUT:
             result = std::string("Timeout");
             break;
-        case 14: // OCASTATUS_BUFFER_OVERFLOW:
+        case OCASTATUS_BUFFER_OVERFLOW:
             result = std::string("BufferOverflow");
             break;
-        case 15: // OCASTATUS_PERMISSION_DENIED:
+        case OCASTATUS_PERMISSION_DENIED:
             result = std::string("PermissionDenied");
             break;
         default:
@@ -596,34 +444,6 @@ std::string HandleToString(std::uint32_t handle)
     return result;
 }
 
-std::uint32_t ReadUint32(const char* buffer)
-{
-    return (((static_cast<std::uint8_t>(buffer[0]) << uint8_24) & 0xff000000) +
-            ((static_cast<std::uint8_t>(buffer[1]) << uint8_16) & 0x00ff0000) +
-            ((static_cast<std::uint8_t>(buffer[2]) << uint8_8)  & 0x0000ff00) +
-              static_cast<std::uint8_t>(buffer[3]));
-}
-
-std::uint32_t ReadUint32(const std::uint8_t* buffer)
-{
-    return (((buffer[0] << uint8_24) & 0xff000000) +
-            ((buffer[1] << uint8_16) & 0x00ff0000) +
-            ((buffer[2] << uint8_8)  & 0x0000ff00) +
-              buffer[3]);
-}
-
-std::uint16_t ReadUint16(const char* buffer)
-{
-    return (((static_cast<std::uint8_t>(buffer[0]) << uint8_8)  & 0xff00) +
-              static_cast<std::uint8_t>(buffer[1]));
-}
-
-std::uint16_t ReadUint16(const std::uint8_t* buffer)
-{
-    return (((buffer[0] << uint8_8)  & 0xff00) +
-              buffer[1]);
-}
-
 std::uint32_t GetONo(std::uint32_t type, std::uint32_t record, std::uint32_t channel, std::uint32_t boxAndObjectNumber)
 {
     return (std::uint32_t((type) & 0xF) << 28)
@@ -641,4 +461,22 @@ std::uint32_t GetONoTy2(std::uint32_t type, std::uint32_t record, std::uint32_t
         | (std::uint32_t((objectNumber) & 0x7F));
 }
 
+std::uint64_t GetPropertyKey(std::uint32_t ono, std::uint16_t propertyDefLevel, std::uint16_t propertyIndex)
+{
+    return (static_cast<std::uint64_t>(ono) << 32)
+        | (static_cast<std::uint64_t>(propertyDefLevel) << 16)
+        | static_cast<std::uint64_t>(propertyIndex);
+}
+
+std::size_t HashPropertyKey(std::uint64_t propertyKey)
+{
+    // Finalizer of splitmix64.
+    propertyKey ^= propertyKey >> 30;
+    propertyKey *= 0xbf58476d1ce4e5b9ULL;
+    propertyKey ^= propertyKey >> 27;
+    propertyKey *= 0x94d049bb133111ebULL;
+    propertyKey ^= propertyKey >> 31;
+    return static_cast<std::size_t>(propertyKey);
+}
+
 }
@@ -21,6 +21,9 @@
 #include <vector>       //< USE std::vector
 #include <string>       //< USE std::to_string
 #include <cmath>        //< USE std::float_t, std::double_t
+#include <span>         //< USE std::span
+
+#include "Ocp1ByteOrder.h"
 
 namespace NanoOcp1
 {
@@ -56,6 +59,113 @@ enum Ocp1DataType
     OCP1DATATYPE_CUSTOM             = 128   // User-defined types
 };
 
+/**
+ * Enumeration of the OcaStatus values a response can carry.
+ * Same names as OcaStatus in OcaBaseDataTypes.h
+ * of the Bosch reference implementation.
+ */
+enum Ocp1Status
+{
+    OCASTATUS_OK                      = 0,
+    OCASTATUS_PROTOCOL_VERSION_ERROR  = 1,
+    OCASTATUS_DEVICE_ERROR            = 2,
+    OCASTATUS_LOCKED                  = 3,
+    OCASTATUS_BAD_FORMAT              = 4,
+    OCASTATUS_BAD_ONO                 = 5,
+    OCASTATUS_PARAMETER_ERROR         = 6,
+    OCASTATUS_PARAMETER_OUT_OF_RANGE  = 7,
+    OCASTATUS_NOT_IMPLEMENTED         = 8,
+    OCASTATUS_INVALID_REQUEST         = 9,
+    OCASTATUS_PROCESSING_FAILED       = 10,
+    OCASTATUS_BAD_METHOD              = 11,
+    OCASTATUS_PARTIALLY_SUCCEEDED     = 12,
+    OCASTATUS_TIMEOUT                 = 13,
+    OCASTATUS_BUFFER_OVERFLOW         = 14,
+    OCASTATUS_PERMISSION_DENIED       = 15
+};
+
+
+/**
+ * 3D position as used by the d&b CdbOcaPositionAgentDeprecated,
+ * marshaled as three 32-bit floats.
+ */
+struct Ocp1Position
+{
+    std::float_t m_x{ 0.0f };
+    std::float_t m_y{ 0.0f };
+    std::float_t m_z{ 0.0f };
+
+    bool operator==(const Ocp1Position&) const = default;
+};
+
+/**
+ * 3D aiming and position, marshaled as six 32-bit floats in the order of
+ * CdbOcaAimingAndPosition::Marshal: the aiming angles first, the position second.
+ */
+struct Ocp1AimingAndPosition
+{
+    std::float_t m_hor{ 0.0f };     // Horizontal aiming (yaw).
+    std::float_t m_vert{ 0.0f };    // Vertical aiming (pitch).
+    std::float_t m_rot{ 0.0f };     // Rotational aiming (roll).
+    std::float_t m_x{ 0.0f };
+    std::float_t m_y{ 0.0f };
+    std::float_t m_z{ 0.0f };
+
+    bool operator==(const Ocp1AimingAndPosition&) const = default;
+};
+
+/**
+ * Read-only view of the packed bits of an OcaBitString. On the wire, a bit string is a
+ * 16-bit bit count followed by the bits, the first bit being the most significant bit
+ * of the first byte. The view does not own the bytes and is only valid as long as they are.
+ */
+class Ocp1BitStringView
+{
+public:
+    Ocp1BitStringView() = default;
+
+    /**
+     * @param[in] bytes     Packed bits, without the bit count.
+     * @param[in] bitCount  Number of valid bits. Limited to the number of bits in bytes.
+     */
+    Ocp1BitStringView(std::span<const std::uint8_t> bytes, std::size_t bitCount)
+        : m_bytes(bytes), m_bitCount(bitCount < bytes.size() * 8 ? bitCount : bytes.size() * 8)
+    {
+    }
+
+    std::size_t size() const noexcept { return m_bitCount; }
+    bool empty() const noexcept { return m_bitCount == 0; }
+
+    /**
+     * @return  The bit at the given index, false if the index is out of range.
+     */
+    bool test(std::size_t index) const noexcept
+    {
+        return index < m_bitCount && (m_bytes[index / 8] & (0x80 >> (index % 8))) != 0;
+    }
+
+    bool operator[](std::size_t index) const noexcept { return test(index); }
+
+    /**
+     * @return  The number of set bits.
+     */
+    std::size_t count() const noexcept;
+
+    /**
+     * @return  The packed bytes holding the valid bits.
+     */
+    std::span<const std::uint8_t> bytes() const noexcept { return m_bytes.first((m_bitCount + 7) / 8); }
+
+    /**
+     * Compares the valid bits, ignoring the padding bits of the last byte.
+     */
+    bool operator==(const Ocp1BitStringView& other) const noexcept;
+
+private:
+    std::span<const std::uint8_t>   m_bytes;
+    std::size_t                     m_bitCount{ 0 };
+};
+
 
 /**
  * @brief  Convenience helper method to convert a byte vector into a bool
@@ -63,7 +173,7 @@ enum Ocp1DataType
  * @param  pOk           Optional parameter to verify if the conversion was successful.
  * @return               The value contained in the parameterData as bool.
  */
-bool DataToBool(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+bool DataToBool(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * @brief  Convenience helper method to convert a bool into a byte vector
@@ -72,6 +182,40 @@ bool DataToBool(const std::vector<std::uint8_t>& parameterData, bool* pOk = null
  */
 std::vector<std::uint8_t> DataFromBool(bool boolValue);
 
+/**
+ * Convenience helper method to convert a byte vector into a Int8
+ *
+ * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int8.
+ */
+std::int8_t DataToInt8(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int8 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+std::vector<std::uint8_t> DataFromInt8(std::int8_t value);
+
+/**
+ * Convenience helper method to convert a byte vector into a Int16
+ *
+ * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int16.
+ */
+std::int16_t DataToInt16(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int16 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+std::vector<std::uint8_t> DataFromInt16(std::int16_t value);
+
 /**
  * Convenience helper method to convert a byte vector into a Int32
  *
@@ -79,7 +223,7 @@ std::vector<std::uint8_t> DataFromBool(bool boolValue);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Int32.
  */
-std::int32_t DataToInt32(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::int32_t DataToInt32(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Int32 into a byte vector
@@ -89,6 +233,23 @@ std::int32_t DataToInt32(const std::vector<std::uint8_t>& parameterData, bool* p
  */
 std::vector<std::uint8_t> DataFromInt32(std::int32_t value);
 
+/**
+ * Convenience helper method to convert a byte vector into a Int64
+ *
+ * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int64.
+ */
+std::int64_t DataToInt64(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int64 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+std::vector<std::uint8_t> DataFromInt64(std::int64_t value);
+
 /**
  * Convenience helper method to convert a byte vector into a Uint8
  * 
@@ -96,7 +257,7 @@ std::vector<std::uint8_t> DataFromInt32(std::int32_t value);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint8.
  */
-std::uint8_t DataToUint8(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::uint8_t DataToUint8(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint8 into a byte vector
@@ -113,7 +274,7 @@ std::vector<std::uint8_t> DataFromUint8(std::uint8_t value);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint16.
  */
-std::uint16_t DataToUint16(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::uint16_t DataToUint16(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint16 into a byte vector
@@ -130,7 +291,7 @@ std::vector<std::uint8_t> DataFromUint16(std::uint16_t value);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint32.
  */
-std::uint32_t DataToUint32(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::uint32_t DataToUint32(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint32 into a byte vector
@@ -147,7 +308,7 @@ std::vector<std::uint8_t> DataFromUint32(std::uint32_t value);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint64.
  */
-std::uint64_t DataToUint64(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::uint64_t DataToUint64(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint64 into a byte vector
@@ -165,7 +326,7 @@ std::vector<std::uint8_t> DataFromUint64(std::uint64_t value);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The string contained in the parameterData as a std::string.
  */
-std::string DataToString(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::string DataToString(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a std::string into a byte vector
@@ -182,7 +343,7 @@ std::vector<std::uint8_t> DataFromString(const std::string& string);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a float.
  */
-std::float_t DataToFloat(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::float_t DataToFloat(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a 32-bit float into a byte vector
@@ -199,7 +360,7 @@ std::vector<std::uint8_t> DataFromFloat(std::float_t floatValue);
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a double.
  */
-std::double_t DataToDouble(const std::vector<std::uint8_t>& parameterData, bool* pOk = nullptr);
+std::double_t DataToDouble(std::span<const std::uint8_t> parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a 64-bit double into a byte vector
@@ -209,6 +370,15 @@ std::double_t DataToDouble(const std::vector<std::uint8_t>& parameterData, bool*
  */
 std::vector<std::uint8_t> DataFromDouble(std::double_t doubleValue);
 
+/**
+ * Convenience helper method to convert bits into a marshaled OcaBitString,
+ * see Ocp1BitStringView for the format.
+ *
+ * @param[in] bits  Bits to be converted, at most 65535.
+ * @return  The bit string as a byte vector, empty if there are too many bits.
+ */
+std::vector<std::uint8_t> DataFromBitString(const std::vector<bool>& bits);
+
 /**
  * Convenience helper method to convert a 3D position (three 32-bit floats) into a byte vector
  *
@@ -279,7 +449,10 @@ std::string HandleToString(std::uint32_t handle);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 4 bytes as an uint32_t.
  */
-std::uint32_t ReadUint32(const char* buffer);
+inline std::uint32_t ReadUint32(const char* buffer)
+{
+    return LoadBigEndian<std::uint32_t>(reinterpret_cast<const std::uint8_t*>(buffer));
+}
 
 /**
  * Convenience method to read 4 bytes from a buffer.
@@ -287,7 +460,10 @@ std::uint32_t ReadUint32(const char* buffer);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 4 bytes as an uint32_t.
  */
-std::uint32_t ReadUint32(const std::uint8_t* buffer);
+inline std::uint32_t ReadUint32(const std::uint8_t* buffer)
+{
+    return LoadBigEndian<std::uint32_t>(buffer);
+}
 
 /**
  * Convenience method to read 2 bytes from a buffer.
@@ -295,7 +471,10 @@ std::uint32_t ReadUint32(const std::uint8_t* buffer);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 2 bytes as an uint16_t.
  */
-std::uint16_t ReadUint16(const char* buffer);
+inline std::uint16_t ReadUint16(const char* buffer)
+{
+    return LoadBigEndian<std::uint16_t>(reinterpret_cast<const std::uint8_t*>(buffer));
+}
 
 /**
  * Convenience method to read 2 bytes from a buffer.
@@ -303,7 +482,10 @@ std::uint16_t ReadUint16(const char* buffer);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 2 bytes as an uint16_t.
  */
-std::uint16_t ReadUint16(const std::uint8_t* buffer);
+inline std::uint16_t ReadUint16(const std::uint8_t* buffer)
+{
+    return LoadBigEndian<std::uint16_t>(buffer);
+}
 
 /**
  * Convenience method to generate a unique target object number.
@@ -330,4 +512,26 @@ std::uint32_t GetONo(std::uint32_t type, std::uint32_t record, std::uint32_t cha
  */
 std::uint32_t GetONoTy2(std::uint32_t type, std::uint32_t record, std::uint32_t channel, std::uint32_t boxNumber, std::uint32_t objectNumber);
 
+/**
+ * Convenience method to pack the triple that uniquely identifies an object property
+ * (ONo, property definition level and property index) into a single 64bit key.
+ * Useful as key for maps of per-property state, e.g. pending Set commands or cached values.
+ *
+ * @param[in] ono                   The object ONo.
+ * @param[in] propertyDefLevel      Level of the property definition within the AES70 class hierarchy.
+ * @param[in] propertyIndex         Index of the property within its AES70 class definition.
+ * @return  The packed property key.
+ */
+std::uint64_t GetPropertyKey(std::uint32_t ono, std::uint16_t propertyDefLevel, std::uint16_t propertyIndex);
+
+/**
+ * Convenience method to hash a property key created by GetPropertyKey for use in hash tables.
+ * The ONos of one device tend to be close to each other, so the key bits are mixed well
+ * enough to allow masking the result to a power of two table size.
+ *
+ * @param[in] propertyKey   The property key to hash.
+ * @return  The hash value.
+ */
+std::size_t HashPropertyKey(std::uint64_t propertyKey);
+
 }
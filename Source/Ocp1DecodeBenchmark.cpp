@@ -0,0 +1,373 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1DecodeBenchmark.h"
+#include "Ocp1Message.h"
+#include "Ocp1Metrics.h"
+#include "Variant.h"
+
+
+namespace NanoOcp1
+{
+
+namespace
+{
+
+/**
+ * Byte-wise reference implementations, as used by the codec before Ocp1ByteOrder.h.
+ */
+template <typename T>
+T LoadBigEndianShifted(const std::uint8_t* buffer)
+{
+    ByteOrderRawType<T> raw(0);
+    for (std::size_t i = 0; i < sizeof(T); i++)
+        raw = static_cast<ByteOrderRawType<T>>((static_cast<std::uint64_t>(raw) << 8) | buffer[i]);
+
+    return std::bit_cast<T>(raw);
+}
+
+template <typename T>
+void StoreBigEndianShifted(std::uint8_t* buffer, T value)
+{
+    auto raw = std::bit_cast<ByteOrderRawType<T>>(value);
+    for (std::size_t i = 0; i < sizeof(T); i++)
+        buffer[i] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(raw) >> (8 * (sizeof(T) - 1 - i)));
+}
+
+/**
+ * Decodes and re-encodes every value in the buffer byte-wise, one value at a time with
+ * the primitives and in bulk with the array kernels, and appends the time per value to the result.
+ */
+template <typename T>
+void BenchmarkByteOrder(const char* typeName, ByteVector& buffer, int iterations, juce::String& result, std::uint64_t& checksum)
+{
+    const auto valueCount = buffer.size() / sizeof(T);
+    const auto totalCount = static_cast<double>(valueCount) * iterations;
+
+    auto time = [](auto&& function)
+    {
+        auto startTicks = juce::Time::getHighResolutionTicks();
+        function();
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    };
+
+    double loadSeconds[3] = {};
+    double storeSeconds[3] = {};
+
+    auto measure = [&](auto useByteOrder, int variant)
+    {
+        loadSeconds[variant] = time([&]
+        {
+            ByteOrderRawType<T> sum(0); // Raw bits, to keep NaNs out of the checksum.
+            for (int i = 0; i < iterations; i++)
+                for (std::size_t j = 0; j < valueCount; j++)
+                {
+                    const auto* data = buffer.data() + j * sizeof(T);
+                    if constexpr (decltype(useByteOrder)::value)
+                        sum ^= std::bit_cast<ByteOrderRawType<T>>(LoadBigEndian<T>(data));
+                    else
+                        sum ^= std::bit_cast<ByteOrderRawType<T>>(LoadBigEndianShifted<T>(data));
+                }
+            checksum += sum;
+        });
+
+        storeSeconds[variant] = time([&]
+        {
+            for (int i = 0; i < iterations; i++)
+                for (std::size_t j = 0; j < valueCount; j++)
+                {
+                    auto* data = buffer.data() + j * sizeof(T);
+                    auto value = static_cast<T>(j + static_cast<std::size_t>(i));
+                    if constexpr (decltype(useByteOrder)::value)
+                        StoreBigEndian(data, value);
+                    else
+                        StoreBigEndianShifted(data, value);
+                }
+            checksum += buffer[static_cast<std::size_t>(iterations) % buffer.size()];
+        });
+    };
+
+    measure(std::false_type{}, 0);
+    measure(std::true_type{}, 1);
+
+    std::vector<T> values(valueCount);
+    loadSeconds[2] = time([&]
+    {
+        for (int i = 0; i < iterations; i++)
+            LoadBigEndianArray(buffer.data(), values.data(), valueCount);
+        checksum += std::bit_cast<ByteOrderRawType<T>>(values[static_cast<std::size_t>(iterations) % valueCount]);
+    });
+
+    storeSeconds[2] = time([&]
+    {
+        for (int i = 0; i < iterations; i++)
+            StoreBigEndianArray(buffer.data(), values.data(), valueCount);
+        checksum += buffer[static_cast<std::size_t>(iterations) % buffer.size()];
+    });
+
+    auto line = [&](const char* direction, const double* seconds)
+    {
+        result << juce::String(typeName).paddedRight(' ', 8) << juce::String(direction).paddedRight(' ', 8)
+            << "shifts " << juce::String(seconds[0] * 1.0e9 / totalCount, 3) << " ns, "
+            << "bswap " << juce::String(seconds[1] * 1.0e9 / totalCount, 3) << " ns, "
+            << "bulk " << juce::String(seconds[2] * 1.0e9 / totalCount, 3) << " ns\n";
+    };
+    line("load", loadSeconds);
+    line("store", storeSeconds);
+}
+
+}
+
+
+//==============================================================================
+double Ocp1DecodeBenchmark::TypeResult::getNanosecondsPerMessage() const
+{
+    return m_messageCount > 0 ? m_seconds * 1.0e9 / static_cast<double>(m_messageCount) : 0.0;
+}
+
+double Ocp1DecodeBenchmark::Result::getMessagesPerSecond() const
+{
+    return m_seconds > 0.0 ? static_cast<double>(m_messageCount) / m_seconds : 0.0;
+}
+
+double Ocp1DecodeBenchmark::Result::getBytesPerSecond() const
+{
+    return m_seconds > 0.0 ? static_cast<double>(m_byteCount) / m_seconds : 0.0;
+}
+
+double Ocp1DecodeBenchmark::Result::getAllocationsPerMessage() const
+{
+    if (m_allocationCount < 0 || m_messageCount == 0)
+        return -1.0;
+
+    return static_cast<double>(m_allocationCount) / static_cast<double>(m_messageCount);
+}
+
+juce::String Ocp1DecodeBenchmark::Result::toString() const
+{
+    static const char* typeNames[MessageTypeCount] = { "Command", "CommandResponseRequired", "Notification", "Response", "KeepAlive" };
+
+    juce::String result;
+    result << "messages:      " << juce::String(static_cast<juce::int64>(m_messageCount)) << " (" << juce::String(static_cast<juce::int64>(m_failureCount)) << " failed)\n";
+    result << "messages/s:    " << juce::String(getMessagesPerSecond(), 0) << "\n";
+    result << "bytes/s:       " << juce::String(getBytesPerSecond(), 0) << "\n";
+    result << "allocs/msg:    " << (m_allocationCount < 0 ? juce::String("n/a") : juce::String(getAllocationsPerMessage(), 2)) << "\n";
+
+    for (int i = 0; i < MessageTypeCount; i++)
+    {
+        const auto& type = m_types[static_cast<std::size_t>(i)];
+        if (type.m_messageCount > 0)
+            result << "ns/msg " << juce::String(typeNames[i]).paddedRight(' ', 24) << juce::String(type.getNanosecondsPerMessage(), 1)
+                << " (" << juce::String(static_cast<juce::int64>(type.m_messageCount)) << " messages)\n";
+    }
+
+    return result;
+}
+
+//==============================================================================
+Ocp1DecodeBenchmark::Ocp1DecodeBenchmark(const std::vector<Ocp1CaptureRecord>& records,
+                                         std::span<const Ocp1CommandDefinition* const> defs,
+                                         Ocp1WireCapture::Direction direction)
+    : m_metrics(std::make_unique<Ocp1Metrics>(nullptr))
+{
+    constexpr std::size_t msgTypeOffset = 7;
+    constexpr std::size_t handleOffset = Ocp1Header::Ocp1HeaderSize + 4;   // After command or response size.
+    constexpr std::size_t targetOnoOffset = handleOffset + 4;
+    constexpr std::size_t methodDefLevelOffset = targetOnoOffset + 4;
+
+    // Value data types by property key, and by ONo and definition level for the Get commands.
+    std::map<std::uint64_t, std::uint16_t> propertyTypes;
+    std::map<std::pair<std::uint32_t, std::uint16_t>, std::uint16_t> getCommandTypes;
+    for (const auto* def : defs)
+    {
+        propertyTypes.emplace(def->GetPropertyKey(), def->m_propertyType);
+        getCommandTypes.emplace(std::make_pair(def->m_targetOno, def->m_propertyDefLevel), def->m_propertyType);
+    }
+
+    std::map<std::uint32_t, std::uint16_t> responseTypes; // By handle.
+
+    for (const auto& record : records)
+    {
+        if (record.isTruncated() || record.m_data.size() < Ocp1Header::Ocp1HeaderSize)
+            continue;
+
+        auto msgType = record.m_data[msgTypeOffset];
+        if (msgType >= MessageTypeCount)
+            continue;
+
+        // Commands of the other direction tell what the responses contain.
+        if (record.m_direction != direction)
+        {
+            if ((msgType == Ocp1Message::Command || msgType == Ocp1Message::CommandResponseRequired) && record.m_data.size() >= methodDefLevelOffset + 2)
+            {
+                auto iter = getCommandTypes.find(std::make_pair(ReadUint32(record.m_data.data() + targetOnoOffset), ReadUint16(record.m_data.data() + methodDefLevelOffset)));
+                if (iter != getCommandTypes.end())
+                    responseTypes[ReadUint32(record.m_data.data() + handleOffset)] = iter->second;
+            }
+            continue;
+        }
+
+        Message message{ record.m_data, msgType, OCP1DATATYPE_BLOB };
+        if (msgType == Ocp1Message::Notification)
+        {
+            auto msgObj = Ocp1Message::UnmarshalOcp1Message(record.m_data, m_metrics.get());
+            if (msgObj)
+            {
+                auto iter = propertyTypes.find(static_cast<Ocp1Notification*>(msgObj.get())->GetPropertyKey());
+                if (iter != propertyTypes.end())
+                    message.m_valueType = iter->second;
+            }
+        }
+        else if (msgType == Ocp1Message::Response && record.m_data.size() >= handleOffset + 4)
+        {
+            auto iter = responseTypes.find(ReadUint32(record.m_data.data() + handleOffset));
+            if (iter != responseTypes.end())
+                message.m_valueType = iter->second;
+        }
+
+        m_messagesByType[msgType].push_back(m_messages.size());
+        m_messages.push_back(std::move(message));
+    }
+}
+
+Ocp1DecodeBenchmark::~Ocp1DecodeBenchmark()
+{
+}
+
+//==============================================================================
+void Ocp1DecodeBenchmark::setAllocationCounter(const AllocationCounter& allocationCounter)
+{
+    m_allocationCounter = allocationCounter;
+}
+
+std::size_t Ocp1DecodeBenchmark::getMessageCount() const
+{
+    return m_messages.size();
+}
+
+Ocp1DecodeBenchmark::Result Ocp1DecodeBenchmark::run(int iterations) const
+{
+    Result result;
+    std::uint64_t checksum = 0;
+
+    // Capture order, for the overall numbers.
+    auto allocationsBefore = m_allocationCounter ? m_allocationCounter() : 0;
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const auto& message : m_messages)
+        {
+            if (!decode(message, checksum))
+                result.m_failureCount++;
+
+            result.m_byteCount += message.m_data.size();
+        }
+    }
+
+    result.m_seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    result.m_messageCount = static_cast<std::uint64_t>(iterations) * m_messages.size();
+    if (m_allocationCounter)
+        result.m_allocationCount = static_cast<std::int64_t>(m_allocationCounter() - allocationsBefore);
+
+    // Grouped by message type, for the time per type.
+    for (int type = 0; type < MessageTypeCount; type++)
+    {
+        const auto& indices = m_messagesByType[static_cast<std::size_t>(type)];
+        auto& typeResult = result.m_types[static_cast<std::size_t>(type)];
+
+        startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (auto index : indices)
+            {
+                decode(m_messages[index], checksum);
+                typeResult.m_byteCount += m_messages[index].m_data.size();
+            }
+        }
+
+        typeResult.m_seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        typeResult.m_messageCount = static_cast<std::uint64_t>(iterations) * indices.size();
+    }
+
+    m_checksum += checksum;
+    return result;
+}
+
+//==============================================================================
+bool Ocp1DecodeBenchmark::decode(const Message& message, std::uint64_t& checksum) const
+{
+    Ocp1Header header(message.m_data);
+    if (!header.IsValid())
+        return false;
+
+    auto msgObj = Ocp1Message::UnmarshalOcp1Message(message.m_data, m_metrics.get());
+    if (!msgObj)
+        return false;
+
+    checksum += msgObj->GetMessageType();
+
+    switch (message.m_messageType)
+    {
+        case Ocp1Message::Notification:
+        {
+            const auto* notification = static_cast<const Ocp1Notification*>(msgObj.get());
+            if (notification->GetParamCount() > 0)
+                checksum += Variant(notification->GetParameterData(), static_cast<Ocp1DataType>(message.m_valueType)).IsValid() ? 1 : 0;
+            break;
+        }
+        case Ocp1Message::Response:
+        {
+            const auto* response = static_cast<const Ocp1Response*>(msgObj.get());
+            if (response->GetParamCount() > 0)
+                checksum += Variant(response->GetParameterData(), static_cast<Ocp1DataType>(message.m_valueType)).IsValid() ? 1 : 0;
+            break;
+        }
+        default:
+            break;
+    }
+
+    return true;
+}
+
+//==============================================================================
+juce::String Ocp1DecodeBenchmark::RunByteOrderBenchmark(int iterations)
+{
+    iterations = juce::jmax(1, iterations);
+
+    // 64 KiB, to stay in the cache and measure the conversion rather than the memory bandwidth.
+    ByteVector buffer(0x10000);
+    juce::Random random(0x4f4341);
+    for (auto& byte : buffer)
+        byte = static_cast<std::uint8_t>(random.nextInt(256));
+
+    juce::String result;
+    std::uint64_t checksum = 0;
+
+    BenchmarkByteOrder<std::uint16_t>("uint16", buffer, iterations, result, checksum);
+    BenchmarkByteOrder<std::uint32_t>("uint32", buffer, iterations, result, checksum);
+    BenchmarkByteOrder<std::uint64_t>("uint64", buffer, iterations, result, checksum);
+    BenchmarkByteOrder<float>("float32", buffer, iterations, result, checksum);
+    BenchmarkByteOrder<double>("float64", buffer, iterations, result, checksum);
+
+    result << "checksum " << juce::String::toHexString(static_cast<juce::int64>(checksum)) << "\n";
+
+    return result;
+}
+
+}
@@ -0,0 +1,150 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include <span>
+
+#include "Ocp1CaptureFile.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1Metrics;
+struct Ocp1CommandDefinition;
+
+
+//==============================================================================
+/**
+    Measures decoding throughput on the messages of a capture, i.e. on a realistic traffic mix.
+
+    Every message goes through the same steps as on reception: Ocp1Header validation,
+    UnmarshalOcp1Message and, for notifications and responses carrying a value, Variant
+    decoding with the property's data type. Data types are taken from the given object
+    definitions. Responses are matched to them through the command with the same handle
+    in the capture. Values of unknown properties are decoded as blobs.
+
+    The messages are decoded once in capture order for the overall numbers, and once per
+    message type, grouped, for the time per message type.
+*/
+class Ocp1DecodeBenchmark
+{
+public:
+    static constexpr int MessageTypeCount = 5; // Command, CommandResponseRequired, Notification, Response, KeepAlive.
+
+    /**
+     * Numbers for one message type.
+     */
+    struct TypeResult
+    {
+        std::uint64_t   m_messageCount{ 0 };
+        std::uint64_t   m_byteCount{ 0 };
+        double          m_seconds{ 0.0 };
+
+        double getNanosecondsPerMessage() const;
+    };
+
+    struct Result
+    {
+        std::uint64_t                               m_messageCount{ 0 };    // Messages decoded, all iterations.
+        std::uint64_t                               m_byteCount{ 0 };
+        double                                      m_seconds{ 0.0 };
+        std::int64_t                                m_allocationCount{ -1 }; // -1 if no AllocationCounter was set.
+        std::uint64_t                               m_failureCount{ 0 };    // Messages that did not decode.
+        std::array<TypeResult, MessageTypeCount>    m_types{};              // Indexed by Ocp1Message::MessageType.
+
+        double getMessagesPerSecond() const;
+        double getBytesPerSecond() const;
+        double getAllocationsPerMessage() const;
+
+        juce::String toString() const;
+    };
+
+    /**
+     * Function returning the number of heap allocations made by the process so far.
+     */
+    using AllocationCounter = std::function<std::uint64_t()>;
+
+public:
+    //==============================================================================
+    /**
+     * Class constructor.
+     *
+     * @param[in] records       Capture to decode.
+     * @param[in] defs          Object definitions to look up value data types in.
+     * @param[in] direction     Messages of the capture to decode. Defaults to the ones received by the capturing side.
+     */
+    Ocp1DecodeBenchmark(const std::vector<Ocp1CaptureRecord>& records,
+                        std::span<const Ocp1CommandDefinition* const> defs = {},
+                        Ocp1WireCapture::Direction direction = Ocp1WireCapture::Direction::Received);
+    ~Ocp1DecodeBenchmark();
+
+    //==============================================================================
+    void setAllocationCounter(const AllocationCounter& allocationCounter);
+
+    std::size_t getMessageCount() const;
+
+    /**
+     * Runs the benchmark.
+     *
+     * @param[in] iterations    Number of times to decode the whole capture.
+     */
+    Result run(int iterations) const;
+
+    //==============================================================================
+    /**
+     * Micro benchmark of the fixed-size big-endian primitives in Ocp1ByteOrder.h.
+     * Encodes and decodes a buffer of 16, 32 and 64 bit integers and floats with byte-wise
+     * shifts, as the codec used to, with LoadBigEndian and StoreBigEndian, and in bulk
+     * with LoadBigEndianArray and StoreBigEndianArray.
+     *
+     * @param[in] iterations    Number of times to process the whole buffer.
+     * @return  Nanoseconds per value for each variant, one line per type and direction.
+     */
+    static juce::String RunByteOrderBenchmark(int iterations);
+
+private:
+    //==============================================================================
+    struct Message
+    {
+        ByteVector      m_data;
+        std::uint8_t    m_messageType{ 0 };
+        std::uint16_t   m_valueType{ 0 };   // Ocp1DataType of the value, if any.
+    };
+
+    //==============================================================================
+    bool decode(const Message& message, std::uint64_t& checksum) const;
+
+    //==============================================================================
+    std::vector<Message>                                        m_messages;     // In capture order.
+    std::array<std::vector<std::size_t>, MessageTypeCount>      m_messagesByType;
+    AllocationCounter                                           m_allocationCounter;
+    std::unique_ptr<Ocp1Metrics>                                m_metrics;      // Keeps decode failures out of the process wide aggregate.
+    mutable std::atomic<std::uint64_t>                          m_checksum{ 0 }; // Keeps the decoded values from being optimized away.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1DecodeBenchmark)
+};
+
+}
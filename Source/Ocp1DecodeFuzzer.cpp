@@ -0,0 +1,259 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1DecodeFuzzer.h"
+#include "Ocp1Codec.h"
+#include "Ocp1Metrics.h"
+
+
+namespace NanoOcp1
+{
+
+namespace
+{
+
+/**
+ * Values that are likely to hit an edge case when written into a size or length field.
+ */
+constexpr std::uint32_t InterestingValues[] = { 0, 1, 2, 9, 10, 11, 13, 16, 17, 27, 28, 29, 0x7f, 0x80, 0xff,
+                                                0x7fff, 0x8000, 0xffff, 0x7fffffff, 0x80000000, 0xffffffff };
+
+/**
+ * Offsets of the message size, type and count in the header, and of the notification, response
+ * or command size, handle or target ONo, status or method, param count and context size after it.
+ */
+constexpr std::size_t FieldOffsets[] = { 3, 7, 8, 10, 14, 18, 19, 20, 22, 23, 25 };
+
+constexpr std::size_t MaxRecordedViolations = 16;
+
+}
+
+//==============================================================================
+juce::String Ocp1DecodeFuzzer::Result::toString() const
+{
+    static const char* errorNames[Ocp1Message::UnmarshalErrorCount] = { "None", "InvalidHeader", "Truncated", "InvalidSize",
+                                                                        "InvalidObjectNumber", "InvalidHandle", "InvalidMethod",
+                                                                        "InvalidEvent", "InvalidProperty", "InvalidParamCount",
+                                                                        "UnsupportedType" };
+
+    juce::String result;
+    result << "inputs:        " << juce::String(static_cast<juce::int64>(m_inputCount)) << "\n";
+    result << "decoded:       " << juce::String(static_cast<juce::int64>(m_decodedCount)) << "\n";
+
+    for (int i = 1; i < Ocp1Message::UnmarshalErrorCount; i++)
+        if (m_errorCounts[static_cast<std::size_t>(i)] > 0)
+            result << "rejected " << juce::String(errorNames[i]).paddedRight(' ', 20)
+                << juce::String(static_cast<juce::int64>(m_errorCounts[static_cast<std::size_t>(i)])) << "\n";
+
+    result << "violations:    " << juce::String(static_cast<juce::int64>(m_violationCount)) << "\n";
+    for (const auto& violation : m_violations)
+        result << "  " << juce::String::toHexString(violation.data(), static_cast<int>(violation.size())) << "\n";
+
+    return result;
+}
+
+//==============================================================================
+Ocp1DecodeFuzzer::Ocp1DecodeFuzzer(juce::int64 seed)
+    : m_corpus(CreateSeedCorpus()), m_random(seed), m_metrics(std::make_unique<Ocp1Metrics>(nullptr))
+{
+}
+
+Ocp1DecodeFuzzer::~Ocp1DecodeFuzzer() = default;
+
+//==============================================================================
+void Ocp1DecodeFuzzer::addToCorpus(const ByteVector& message)
+{
+    m_corpus.push_back(message);
+}
+
+void Ocp1DecodeFuzzer::addToCorpus(const std::vector<Ocp1CaptureRecord>& records)
+{
+    for (const auto& record : records)
+        if (!record.isTruncated())
+            m_corpus.push_back(record.m_data);
+}
+
+const std::vector<ByteVector>& Ocp1DecodeFuzzer::getCorpus() const
+{
+    return m_corpus;
+}
+
+Ocp1DecodeFuzzer::Result Ocp1DecodeFuzzer::run(int iterations)
+{
+    Result result;
+
+    auto checkInput = [this, &result](const ByteVector& input)
+    {
+        Ocp1Message::UnmarshalError error;
+        auto ok = check(input, &error);
+
+        result.m_inputCount++;
+        if (error == Ocp1Message::UnmarshalError::None)
+            result.m_decodedCount++;
+        else
+            result.m_errorCounts[static_cast<std::size_t>(error)]++;
+
+        if (!ok)
+        {
+            result.m_violationCount++;
+            if (result.m_violations.size() < MaxRecordedViolations)
+                result.m_violations.push_back(input);
+        }
+    };
+
+    for (const auto& message : m_corpus)
+        checkInput(message);
+
+    if (m_corpus.empty())
+        return result;
+
+    for (int i = 0; i < iterations; i++)
+        checkInput(mutate(m_corpus[static_cast<std::size_t>(m_random.nextInt(static_cast<int>(m_corpus.size())))]));
+
+    return result;
+}
+
+bool Ocp1DecodeFuzzer::check(const ByteVector& input, Ocp1Message::UnmarshalError* pError) const
+{
+    // Copied into a buffer of exactly the input's size, so reads beyond it are caught by address sanitizer.
+    std::unique_ptr<std::uint8_t[]> buffer(new std::uint8_t[juce::jmax<std::size_t>(1, input.size())]);
+    if (!input.empty())
+        std::memcpy(buffer.get(), input.data(), input.size());
+
+    auto error = Ocp1Message::UnmarshalError::None;
+    auto msgObj = Ocp1Message::UnmarshalOcp1Message(std::span<const std::uint8_t>(buffer.get(), input.size()), &error, m_metrics.get());
+    if (pError != nullptr)
+        *pError = error;
+
+    if (msgObj == nullptr)
+        return error != Ocp1Message::UnmarshalError::None;
+
+    if (error != Ocp1Message::UnmarshalError::None)
+        return false;
+
+    // What was decoded needs to survive a round trip unchanged.
+    auto serializedData = msgObj->GetSerializedData();
+    auto roundTripObj = Ocp1Message::UnmarshalOcp1Message(std::span<const std::uint8_t>(serializedData), &error, m_metrics.get());
+
+    return roundTripObj != nullptr && roundTripObj->GetSerializedData() == serializedData;
+}
+
+//==============================================================================
+std::vector<ByteVector> Ocp1DecodeFuzzer::CreateSeedCorpus()
+{
+    std::vector<ByteVector> corpus;
+
+    // Notifications with values of different sizes: bool, float, position, aiming and position, string list.
+    corpus.push_back(Ocp1Notification(0x10001001, 4, 1, 1, DataFromBool(true)).GetSerializedData());
+    corpus.push_back(Ocp1Notification(0x10001001, 4, 1, 1, DataFromFloat(-12.5f)).GetSerializedData());
+    corpus.push_back(Ocp1Notification(0x10002001, 5, 2, 1, DataFromPosition(1.0f, 2.0f, 3.0f)).GetSerializedData());
+    corpus.push_back(Ocp1Notification(0x10002001, 5, 2, 1, DataFromAimingAndPosition(10.0f, 20.0f, 30.0f, 1.0f, 2.0f, 3.0f)).GetSerializedData());
+    corpus.push_back(Ocp1Notification(0x10003001, 4, 2, 1, DataFrom(std::vector<std::string>{ "Modern", "Classic", "Large Hall" })).GetSerializedData());
+
+    // Notification with a context, which shifts all event fields.
+    {
+        auto notification = Ocp1Notification(0x10001001, 4, 1, 1, DataFromFloat(1.0f)).GetSerializedData();
+        const ByteVector context = { 0xde, 0xad, 0xbe, 0xef };
+        notification.insert(notification.begin() + 25, context.begin(), context.end());
+        StoreBigEndian(notification.data() + 3, static_cast<std::uint32_t>(notification.size() - 1));
+        StoreBigEndian(notification.data() + 10, static_cast<std::uint32_t>(notification.size() - Ocp1Header::Ocp1HeaderSize));
+        StoreBigEndian(notification.data() + 23, static_cast<std::uint16_t>(context.size()));
+        corpus.push_back(notification);
+    }
+
+    // Responses with and without parameters.
+    corpus.push_back(Ocp1Response(42, 0, 1, DataFromUint16(3)).GetSerializedData());
+    corpus.push_back(Ocp1Response(43, 0, 1, DataFromString("DS100")).GetSerializedData());
+    corpus.push_back(Ocp1Response(44, 5, 0, ByteVector{}).GetSerializedData());
+
+    // Commands with and without parameters.
+    {
+        Ocp1CommandResponseRequired command(0x10001001, 4, 2, 1, DataFromFloat(-6.0f));
+        command.SetHandle(45);
+        corpus.push_back(command.GetSerializedData());
+    }
+    {
+        Ocp1CommandResponseRequired command(0x10001001, 4, 1, 0, ByteVector{});
+        command.SetHandle(46);
+        corpus.push_back(command.GetSerializedData());
+    }
+
+    // Keep alives in seconds and in milliseconds.
+    corpus.push_back(Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData());
+    corpus.push_back(Ocp1KeepAlive(static_cast<std::uint32_t>(1500)).GetSerializedData());
+
+    return corpus;
+}
+
+//==============================================================================
+ByteVector Ocp1DecodeFuzzer::mutate(const ByteVector& message)
+{
+    auto pick = [this](auto& values) -> const auto& { return values[static_cast<std::size_t>(m_random.nextInt(static_cast<int>(std::size(values))))]; };
+    auto randomIndex = [this](const ByteVector& input) { return static_cast<std::size_t>(m_random.nextInt(static_cast<int>(input.size()))); };
+
+    auto input = message;
+    auto mutationCount = 1 + m_random.nextInt(3);
+    for (int i = 0; i < mutationCount; i++)
+    {
+        switch (m_random.nextInt(6))
+        {
+            case 0: // Flip a bit.
+                if (!input.empty())
+                    input[randomIndex(input)] ^= static_cast<std::uint8_t>(1 << m_random.nextInt(8));
+                break;
+            case 1: // Overwrite a byte.
+                if (!input.empty())
+                    input[randomIndex(input)] = static_cast<std::uint8_t>(pick(InterestingValues));
+                break;
+            case 2: // Overwrite a field with an interesting value.
+                {
+                    auto offset = pick(FieldOffsets);
+                    auto value = pick(InterestingValues);
+                    if (m_random.nextBool() && offset + sizeof(std::uint16_t) <= input.size())
+                        StoreBigEndian(input.data() + offset, static_cast<std::uint16_t>(value));
+                    else if (offset + sizeof(std::uint32_t) <= input.size())
+                        StoreBigEndian(input.data() + offset, value);
+                }
+                break;
+            case 3: // Truncate.
+                input.resize(static_cast<std::size_t>(m_random.nextInt(static_cast<int>(input.size()) + 1)));
+                break;
+            case 4: // Append random bytes.
+                for (int j = 1 + m_random.nextInt(16); j > 0; j--)
+                    input.push_back(static_cast<std::uint8_t>(m_random.nextInt(256)));
+                break;
+            case 5: // Get a size field slightly wrong.
+                {
+                    auto offset = m_random.nextBool() ? std::size_t(3) : Ocp1Header::Ocp1HeaderSize;
+                    if (offset + sizeof(std::uint32_t) <= input.size())
+                        StoreBigEndian(input.data() + offset, LoadBigEndian<std::uint32_t>(input.data() + offset) + static_cast<std::uint32_t>(m_random.nextInt(9) - 4));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Most inputs get a message size matching their length, for the mutations to reach beyond the header check.
+    if (input.size() >= Ocp1Header::Ocp1HeaderSize && m_random.nextInt(4) != 0)
+        StoreBigEndian(input.data() + 3, static_cast<std::uint32_t>(input.size() - 1));
+
+    return input;
+}
+
+}
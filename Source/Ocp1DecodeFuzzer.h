@@ -0,0 +1,109 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1CaptureFile.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1Metrics;
+
+
+//==============================================================================
+/**
+    Robustness check of Ocp1Message::UnmarshalOcp1Message against malformed input.
+
+    Starting from a corpus of well-formed messages of every type, optionally extended by the
+    messages of a capture, the decoder is fed with randomly mutated copies: flipped bits,
+    overwritten size and length fields, truncated and extended buffers. Every input is passed
+    in a buffer of exactly its size, so a build with address sanitizer catches any read beyond it.
+
+    For every input it is verified that the decoder either returns a message or reports an
+    error, and that every decoded message serializes into a message that decodes to the same.
+*/
+class Ocp1DecodeFuzzer
+{
+public:
+    struct Result
+    {
+        std::uint64_t                                                   m_inputCount{ 0 };
+        std::uint64_t                                                   m_decodedCount{ 0 };
+        std::array<std::uint64_t, Ocp1Message::UnmarshalErrorCount>     m_errorCounts{};    // Indexed by Ocp1Message::UnmarshalError.
+        std::uint64_t                                                   m_violationCount{ 0 }; // Inputs failing one of the checks.
+        std::vector<ByteVector>                                         m_violations;       // The first few of them, for reproduction.
+
+        juce::String toString() const;
+    };
+
+public:
+    //==============================================================================
+    /**
+     * Class constructor.
+     *
+     * @param[in] seed  Seed of the mutations, to make runs reproducible.
+     */
+    explicit Ocp1DecodeFuzzer(juce::int64 seed = 0);
+    ~Ocp1DecodeFuzzer();
+
+    //==============================================================================
+    void addToCorpus(const ByteVector& message);
+    void addToCorpus(const std::vector<Ocp1CaptureRecord>& records);
+    const std::vector<ByteVector>& getCorpus() const;
+
+    /**
+     * Runs the given number of mutated inputs through the decoder. The unmutated corpus is decoded first.
+     */
+    Result run(int iterations);
+
+    /**
+     * Checks a single input, e.g. one of Result::m_violations.
+     *
+     * @return  True if the decoder behaved as expected.
+     */
+    bool check(const ByteVector& input, Ocp1Message::UnmarshalError* pError = nullptr) const;
+
+    //==============================================================================
+    /**
+     * @return  Well-formed messages of every type: notifications with values of different
+     *          sizes and with a context, responses, commands and both kinds of keep alive.
+     */
+    static std::vector<ByteVector> CreateSeedCorpus();
+
+private:
+    //==============================================================================
+    ByteVector mutate(const ByteVector& message);
+
+    //==============================================================================
+    std::vector<ByteVector>         m_corpus;
+    juce::Random                    m_random;
+    std::unique_ptr<Ocp1Metrics>    m_metrics;      // Keeps the expected decode failures out of the process wide aggregate.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1DecodeFuzzer)
+};
+
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1Heartbeat.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1Heartbeat::Ocp1Heartbeat(const std::function<bool(const ByteVector&)>& sendFunction)
+    : m_sendFunction(sendFunction)
+{
+}
+
+Ocp1Heartbeat::~Ocp1Heartbeat()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void Ocp1Heartbeat::setHeartbeat(int heartbeatMs)
+{
+    m_heartbeatMs = juce::jmax(0, heartbeatMs);
+}
+
+int Ocp1Heartbeat::getHeartbeat() const
+{
+    return m_heartbeatMs;
+}
+
+//==============================================================================
+void Ocp1Heartbeat::start()
+{
+    m_sendIntervalMs = m_heartbeatMs.load();
+    if (m_sendIntervalMs == 0)
+        return;
+
+    // The first KeepAlive announces the heartbeat to the peer.
+    timerCallback();
+    startTimer(m_sendIntervalMs);
+}
+
+void Ocp1Heartbeat::stop()
+{
+    stopTimer();
+    m_sendIntervalMs = 0;
+    m_peerHeartbeatMs = 0;
+}
+
+void Ocp1Heartbeat::keepAliveReceived(const Ocp1KeepAlive& keepAlive)
+{
+    m_peerHeartbeatMs = static_cast<int>(keepAlive.GetHeartBeatTimeMs());
+
+    // Nothing configured here, so follow the peer.
+    if (m_heartbeatMs == 0 && m_peerHeartbeatMs > 0 && m_sendIntervalMs != m_peerHeartbeatMs)
+    {
+        m_sendIntervalMs = m_peerHeartbeatMs.load();
+        timerCallback();
+        startTimer(m_sendIntervalMs);
+    }
+}
+
+//==============================================================================
+int Ocp1Heartbeat::getReceiveTimeout() const
+{
+    auto heartbeatMs = m_peerHeartbeatMs > 0 ? m_peerHeartbeatMs.load() : m_sendIntervalMs.load();
+    return 2 * heartbeatMs;
+}
+
+ByteVector Ocp1Heartbeat::CreateKeepAlive(int heartbeatMs)
+{
+    if (heartbeatMs % 1000 == 0 && heartbeatMs / 1000 <= 0xFFFF)
+        return Ocp1KeepAlive(static_cast<std::uint16_t>(heartbeatMs / 1000)).GetMemoryBlock();
+
+    return Ocp1KeepAlive(static_cast<std::uint32_t>(heartbeatMs)).GetMemoryBlock();
+}
+
+//==============================================================================
+void Ocp1Heartbeat::timerCallback()
+{
+    if (m_sendFunction && m_sendIntervalMs > 0)
+        m_sendFunction(CreateKeepAlive(m_sendIntervalMs));
+}
+
+
+}
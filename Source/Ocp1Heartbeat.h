@@ -0,0 +1,110 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+    #include <juce_events/juce_events.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1KeepAlive;
+
+
+//==============================================================================
+/**
+    Sends KeepAlive messages on a heartbeat and derives the receive timeout
+    used to detect a silent peer.
+
+    The own heartbeat is announced to the peer with the first KeepAlive sent after
+    the connection was made, and is repeated on every heartbeat from then on.
+    If the peer announces a heartbeat of its own, that one is what the supervision
+    relies on, since it is the interval the peer promised to send at. Without an own
+    heartbeat configured, the peer's heartbeat is adopted, so that the side that did
+    not configure anything still keeps the connection alive.
+
+    A connection is considered lost if nothing was received for two heartbeats.
+*/
+class Ocp1Heartbeat : private juce::Timer
+{
+public:
+    //==============================================================================
+    Ocp1Heartbeat(const std::function<bool(const ByteVector&)>& sendFunction);
+    ~Ocp1Heartbeat() override;
+
+    //==============================================================================
+    /**
+     * Sets the own heartbeat. Takes effect with the next connection.
+     *
+     * @param[in] heartbeatMs   Interval to send KeepAlive messages at. 0 to only follow the peer's heartbeat.
+     */
+    void setHeartbeat(int heartbeatMs);
+    int getHeartbeat() const;
+
+    //==============================================================================
+    /**
+     * Starts sending KeepAlive messages, if an own heartbeat is set. To be called when the connection was made.
+     */
+    void start();
+
+    /**
+     * Stops sending KeepAlive messages and forgets the peer's heartbeat. To be called when the connection was lost.
+     */
+    void stop();
+
+    /**
+     * Takes note of the heartbeat announced by the peer.
+     */
+    void keepAliveReceived(const Ocp1KeepAlive& keepAlive);
+
+    //==============================================================================
+    /**
+     * Time without receiving anything after which the connection is to be considered lost.
+     *
+     * @return  Two heartbeats in milliseconds, or 0 if there is no heartbeat to supervise.
+     */
+    int getReceiveTimeout() const;
+
+    /**
+     * Creates a serialized KeepAlive message announcing the given heartbeat.
+     * The 16bit seconds form is used when possible, the 32bit milliseconds form otherwise.
+     */
+    static ByteVector CreateKeepAlive(int heartbeatMs);
+
+private:
+    //==============================================================================
+    void timerCallback() override;
+
+    //==============================================================================
+    std::function<bool(const ByteVector&)>  m_sendFunction;
+    std::atomic<int>                        m_heartbeatMs{ 0 };     // Own heartbeat as configured.
+    std::atomic<int>                        m_peerHeartbeatMs{ 0 }; // Heartbeat announced by the peer, 0 if none yet.
+    std::atomic<int>                        m_sendIntervalMs{ 0 };  // Heartbeat KeepAlive messages are currently sent at.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1Heartbeat)
+};
+
+}
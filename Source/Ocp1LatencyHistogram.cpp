@@ -0,0 +1,151 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1LatencyHistogram.h"
+
+#include <bit>
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1LatencyHistogram::Ocp1LatencyHistogram()
+{
+}
+
+Ocp1LatencyHistogram::~Ocp1LatencyHistogram()
+{
+}
+
+//==============================================================================
+void Ocp1LatencyHistogram::record(std::uint64_t valueUs)
+{
+    m_buckets[static_cast<std::size_t>(GetBucketIndex(valueUs))].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(valueUs, std::memory_order_relaxed);
+
+    auto min = m_min.load(std::memory_order_relaxed);
+    while (valueUs < min && !m_min.compare_exchange_weak(min, valueUs, std::memory_order_relaxed))
+        ;
+
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (valueUs > max && !m_max.compare_exchange_weak(max, valueUs, std::memory_order_relaxed))
+        ;
+}
+
+void Ocp1LatencyHistogram::recordTicks(std::int64_t startTicks, std::int64_t endTicks)
+{
+    if (endTicks < startTicks)
+        return;
+
+    record(static_cast<std::uint64_t>(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1000000.0));
+}
+
+void Ocp1LatencyHistogram::reset()
+{
+    for (auto& bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::uint64_t Ocp1LatencyHistogram::getCount() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Ocp1LatencyHistogram::getMin() const
+{
+    auto min = m_min.load(std::memory_order_relaxed);
+    return min == std::numeric_limits<std::uint64_t>::max() ? 0 : min;
+}
+
+std::uint64_t Ocp1LatencyHistogram::getMax() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double Ocp1LatencyHistogram::getMean() const
+{
+    auto count = getCount();
+    if (count == 0)
+        return 0.0;
+
+    return static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(count);
+}
+
+std::uint64_t Ocp1LatencyHistogram::getPercentile(double percentile) const
+{
+    // Sum up the buckets instead of relying on m_count, which might be off by concurrent recording.
+    std::uint64_t count = 0;
+    for (const auto& bucket : m_buckets)
+        count += bucket.load(std::memory_order_relaxed);
+
+    if (count == 0)
+        return 0;
+
+    auto target = static_cast<std::uint64_t>(std::ceil(juce::jlimit(0.0, 100.0, percentile) * 0.01 * static_cast<double>(count)));
+    target = juce::jlimit(std::uint64_t(1), count, target);
+
+    std::uint64_t cumulated = 0;
+    for (int i = 0; i < BucketCount; i++)
+    {
+        cumulated += m_buckets[static_cast<std::size_t>(i)].load(std::memory_order_relaxed);
+        if (cumulated >= target)
+            return juce::jmin(GetBucketValue(i), getMax());
+    }
+
+    return getMax();
+}
+
+//==============================================================================
+int Ocp1LatencyHistogram::GetBucketIndex(std::uint64_t valueUs)
+{
+    if (valueUs < static_cast<std::uint64_t>(SubBucketCount))
+        return static_cast<int>(valueUs);
+
+    // Position of the highest set bit, the bits below it select the sub-bucket.
+    auto exponent = static_cast<int>(std::bit_width(valueUs)) - 1;
+
+    if (exponent >= MaxExponent)
+        return BucketCount - 1;
+
+    auto subBucket = static_cast<int>((valueUs >> (exponent - SubBucketBits)) & (SubBucketCount - 1));
+    return SubBucketCount + (exponent - SubBucketBits) * SubBucketCount + subBucket;
+}
+
+std::uint64_t Ocp1LatencyHistogram::GetBucketValue(int bucketIndex)
+{
+    if (bucketIndex < SubBucketCount)
+        return static_cast<std::uint64_t>(bucketIndex);
+
+    // Report the middle of the bucket.
+    auto exponent = (bucketIndex - SubBucketCount) / SubBucketCount + SubBucketBits;
+    auto subBucket = static_cast<std::uint64_t>((bucketIndex - SubBucketCount) % SubBucketCount);
+    auto bucketWidth = std::uint64_t(1) << (exponent - SubBucketBits);
+    return ((SubBucketCount + subBucket) * bucketWidth) + bucketWidth / 2;
+}
+
+
+}
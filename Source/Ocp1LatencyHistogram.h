@@ -0,0 +1,97 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Lock-free histogram of latencies in microseconds, in the spirit of HdrHistogram.
+
+    Values below 32us are counted exactly. Above, every power of two range is split
+    into 32 linear sub-buckets, which bounds the relative error of reported values to
+    about 3% over the whole range. Recording a value is a handful of relaxed atomic
+    operations, so it can be done on any thread without disturbing the measured path.
+*/
+class Ocp1LatencyHistogram
+{
+public:
+    //==============================================================================
+    Ocp1LatencyHistogram();
+    ~Ocp1LatencyHistogram();
+
+    //==============================================================================
+    /**
+     * Counts a single latency value.
+     *
+     * @param[in] valueUs   Latency in microseconds. Values beyond about 19 hours are clamped.
+     */
+    void record(std::uint64_t valueUs);
+
+    /**
+     * Convenience method to count the time between two juce::Time::getHighResolutionTicks values.
+     */
+    void recordTicks(std::int64_t startTicks, std::int64_t endTicks);
+
+    void reset();
+
+    //==============================================================================
+    std::uint64_t getCount() const;
+    std::uint64_t getMin() const;
+    std::uint64_t getMax() const;
+    double getMean() const;
+
+    /**
+     * Gets the value below which the given percentage of all recorded values lie.
+     *
+     * @param[in] percentile    Percentile to query, i.e. 50.0, 99.0 or 99.9.
+     * @return  The latency in microseconds, or 0 if nothing was recorded.
+     */
+    std::uint64_t getPercentile(double percentile) const;
+
+private:
+    //==============================================================================
+    static constexpr int SubBucketBits = 5;
+    static constexpr int SubBucketCount = 1 << SubBucketBits;
+    static constexpr int MaxExponent = 36;
+    static constexpr int BucketCount = SubBucketCount + (MaxExponent - SubBucketBits) * SubBucketCount;
+
+    static int GetBucketIndex(std::uint64_t valueUs);
+    static std::uint64_t GetBucketValue(int bucketIndex);
+
+    //==============================================================================
+    std::array<std::atomic<std::uint64_t>, BucketCount> m_buckets{};
+    std::atomic<std::uint64_t>  m_count{ 0 };
+    std::atomic<std::uint64_t>  m_sum{ 0 };
+    std::atomic<std::uint64_t>  m_min{ std::numeric_limits<std::uint64_t>::max() };
+    std::atomic<std::uint64_t>  m_max{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1LatencyHistogram)
+};
+
+}
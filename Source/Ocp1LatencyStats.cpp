@@ -0,0 +1,148 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1LatencyStats.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1LatencyStats::Ocp1LatencyStats()
+{
+}
+
+Ocp1LatencyStats::~Ocp1LatencyStats()
+{
+}
+
+//==============================================================================
+void Ocp1LatencyStats::commandEnqueued(const ByteVector& data)
+{
+    std::uint32_t handle;
+    if (!GetCommandHandle(data, Ocp1Message::CommandResponseRequired, handle))
+        return;
+
+    auto& pending = m_pendingCommands[handle & (PendingTableSize - 1)];
+
+    // Invalidate the slot while it is being filled, since responseReceived might look at it concurrently.
+    pending.m_handle.store(0, std::memory_order_relaxed);
+    pending.m_enqueuedTicks.store(juce::Time::getHighResolutionTicks(), std::memory_order_relaxed);
+    pending.m_writtenTicks.store(0, std::memory_order_relaxed);
+    pending.m_method.store(static_cast<int>(GetMethod(data)), std::memory_order_relaxed);
+    pending.m_handle.store(handle, std::memory_order_release);
+}
+
+void Ocp1LatencyStats::commandWritten(const ByteVector& data)
+{
+    std::uint32_t handle;
+    if (!GetCommandHandle(data, Ocp1Message::CommandResponseRequired, handle))
+        return;
+
+    auto& pending = m_pendingCommands[handle & (PendingTableSize - 1)];
+    if (pending.m_handle.load(std::memory_order_acquire) == handle)
+        pending.m_writtenTicks.store(juce::Time::getHighResolutionTicks(), std::memory_order_release);
+}
+
+void Ocp1LatencyStats::responseReceived(const ByteVector& data)
+{
+    std::uint32_t handle;
+    if (!GetCommandHandle(data, Ocp1Message::Response, handle))
+        return;
+
+    auto nowTicks = juce::Time::getHighResolutionTicks();
+
+    auto& pending = m_pendingCommands[handle & (PendingTableSize - 1)];
+    if (pending.m_handle.load(std::memory_order_acquire) != handle)
+        return; // Not measured, or already overwritten by a newer command.
+
+    auto method = pending.m_method.load(std::memory_order_relaxed);
+    auto enqueuedTicks = pending.m_enqueuedTicks.load(std::memory_order_relaxed);
+    auto writtenTicks = pending.m_writtenTicks.load(std::memory_order_acquire);
+
+    // Every response is measured once.
+    auto expectedHandle = handle;
+    if (!pending.m_handle.compare_exchange_strong(expectedHandle, 0, std::memory_order_relaxed))
+        return;
+
+    getHistogram(method, Stage::Total).recordTicks(enqueuedTicks, nowTicks);
+    if (writtenTicks != 0)
+    {
+        getHistogram(method, Stage::Queue).recordTicks(enqueuedTicks, writtenTicks);
+        getHistogram(method, Stage::RoundTrip).recordTicks(writtenTicks, nowTicks);
+    }
+}
+
+//==============================================================================
+const Ocp1LatencyHistogram& Ocp1LatencyStats::getHistogram(Method method, Stage stage) const
+{
+    return m_histograms[static_cast<std::size_t>(static_cast<int>(method) * StageCount + static_cast<int>(stage))];
+}
+
+Ocp1LatencyHistogram& Ocp1LatencyStats::getHistogram(int method, Stage stage)
+{
+    return m_histograms[static_cast<std::size_t>(juce::jlimit(0, MethodCount - 1, method) * StageCount + static_cast<int>(stage))];
+}
+
+void Ocp1LatencyStats::reset()
+{
+    for (auto& histogram : m_histograms)
+        histogram.reset();
+}
+
+Ocp1LatencyStats::Method Ocp1LatencyStats::GetMethod(const ByteVector& data)
+{
+    constexpr std::size_t msgTypeOffset = 7;
+    constexpr std::size_t targetOnoOffset = Ocp1Header::Ocp1HeaderSize + 8; // After command size and handle.
+    constexpr std::size_t methodIdxOffset = targetOnoOffset + 6;            // After target ONo and method def level.
+    constexpr std::uint32_t subscriptionManagerONo = 0x00000004;
+
+    if (data.size() < methodIdxOffset + 2 || data[msgTypeOffset] != Ocp1Message::CommandResponseRequired)
+        return Method::Other;
+
+    const auto methodIdx = ReadUint16(data.data() + methodIdxOffset);
+
+    if (ReadUint32(data.data() + targetOnoOffset) == subscriptionManagerONo)
+        return methodIdx == 1 ? Method::AddSubscription : Method::Other;
+
+    if (methodIdx == 1) // Get method is usually MethodIdx 1
+        return Method::Get;
+
+    if (methodIdx == 2) // Set method is usually MethodIdx 2
+        return Method::Set;
+
+    return Method::Other;
+}
+
+//==============================================================================
+bool Ocp1LatencyStats::GetCommandHandle(const ByteVector& data, std::uint8_t expectedMsgType, std::uint32_t& handle)
+{
+    constexpr std::size_t msgTypeOffset = 7;
+    constexpr std::size_t handleOffset = Ocp1Header::Ocp1HeaderSize + 4; // After command or response size.
+
+    if (data.size() < handleOffset + 4 || data[msgTypeOffset] != expectedMsgType)
+        return false;
+
+    handle = ReadUint32(data.data() + handleOffset);
+    return handle != 0;
+}
+
+
+}
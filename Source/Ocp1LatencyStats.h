@@ -0,0 +1,118 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+#include "Ocp1LatencyHistogram.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Round-trip latency statistics of the commands sent over a single connection.
+
+    Every serialized Ocp1CommandResponseRequired is timestamped when it is handed to
+    the connection (enqueued), when it is written to the socket and when the matching
+    Ocp1Response arrives. The timestamps are kept in a fixed size table indexed by the
+    command handle, so that no lock or allocation is needed on any of these paths.
+    If more commands than the table holds are outstanding at once, the oldest ones are
+    not measured.
+
+    The resulting latencies are recorded into one histogram per method and stage.
+*/
+class Ocp1LatencyStats
+{
+public:
+    /**
+     * Method class of a command, as far as latencies are concerned.
+     */
+    enum class Method
+    {
+        Get = 0,
+        Set,
+        AddSubscription,
+        Other
+    };
+    static constexpr int MethodCount = 4;
+
+    /**
+     * Part of the command lifetime a latency covers.
+     */
+    enum class Stage
+    {
+        Queue = 0,      // Enqueued until written to the socket, i.e. time spent in the rate limiter.
+        RoundTrip,      // Written to the socket until the response arrived.
+        Total           // Enqueued until the response arrived.
+    };
+    static constexpr int StageCount = 3;
+
+public:
+    //==============================================================================
+    Ocp1LatencyStats();
+    ~Ocp1LatencyStats();
+
+    //==============================================================================
+    void commandEnqueued(const ByteVector& data);
+    void commandWritten(const ByteVector& data);
+    void responseReceived(const ByteVector& data);
+
+    //==============================================================================
+    const Ocp1LatencyHistogram& getHistogram(Method method, Stage stage) const;
+    void reset();
+
+    /**
+     * Classifies a serialized command.
+     *
+     * @return  The command's method class. Other for anything but Ocp1CommandResponseRequired.
+     */
+    static Method GetMethod(const ByteVector& data);
+
+private:
+    //==============================================================================
+    static constexpr std::size_t PendingTableSize = 4096;   // Power of two.
+
+    struct PendingCommand
+    {
+        std::atomic<std::uint32_t>  m_handle{ 0 };
+        std::atomic<std::int64_t>   m_enqueuedTicks{ 0 };
+        std::atomic<std::int64_t>   m_writtenTicks{ 0 };
+        std::atomic<int>            m_method{ 0 };
+    };
+
+    //==============================================================================
+    static bool GetCommandHandle(const ByteVector& data, std::uint8_t expectedMsgType, std::uint32_t& handle);
+    Ocp1LatencyHistogram& getHistogram(int method, Stage stage);
+
+    //==============================================================================
+    std::array<PendingCommand, PendingTableSize>                    m_pendingCommands;
+    std::array<Ocp1LatencyHistogram, MethodCount * StageCount>      m_histograms;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1LatencyStats)
+};
+
+}
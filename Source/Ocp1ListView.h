@@ -0,0 +1,468 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>      //< USE std::size_t, std::ptrdiff_t
+#include <iterator>     //< USE std::forward_iterator_tag
+#include <span>         //< USE std::span
+#include <string>       //< USE std::string
+#include <string_view>  //< USE std::string_view
+#include <utility>      //< USE std::pair
+#include <vector>       //< USE std::vector
+
+#include "Ocp1ByteOrder.h"
+#include "Ocp1Codec.h"
+#include "Ocp1DataTypes.h"
+
+namespace NanoOcp1
+{
+
+/**
+ * Describes how an element of type T is accessed in place by Ocp1ListView and Ocp1MapView.
+ *
+ * Every specialization provides:
+ *  - using ValueType: the type yielded when iterating, a view for variable-size types.
+ *  - static std::size_t Measure(std::span<const std::uint8_t> buffer):
+ *      the marshaled size of the element at the start of the buffer, or 0 if it is incomplete.
+ *  - static ValueType Get(std::span<const std::uint8_t> buffer):
+ *      the element at the start of the buffer, which has already been measured.
+ *
+ * T is the same type that would be used with Ocp1Codec, i.e. std::string for OcaString,
+ * which is yielded as std::string_view, and std::vector<std::uint8_t> for OcaBlob,
+ * which is yielded as a std::span of its bytes.
+ */
+template <typename T>
+struct Ocp1ViewElement;
+
+/**
+ * Elements of fixed size are decoded by value, using their Ocp1Codec.
+ */
+template <typename T>
+    requires (Ocp1Codec<T>::Size != Ocp1VariableSize)
+struct Ocp1ViewElement<T>
+{
+    using ValueType = T;
+
+    static constexpr std::size_t Size = Ocp1Codec<T>::Size;
+
+    static constexpr std::size_t Measure(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return buffer.size() >= Size ? Size : 0;
+    }
+
+    static ValueType Get(std::span<const std::uint8_t> buffer) noexcept
+    {
+        if constexpr (Ocp1SequenceCodec::IsBulk<T>)
+        {
+            return LoadBigEndian<T>(buffer.data());
+        }
+        else
+        {
+            T value{};
+            Ocp1Codec<T>::Decode(buffer, value);
+            return value;
+        }
+    }
+};
+
+template <>
+struct Ocp1ViewElement<std::string>
+{
+    using ValueType = std::string_view;
+
+    static std::size_t Measure(std::span<const std::uint8_t> buffer) noexcept
+    {
+        if (buffer.size() < sizeof(std::uint16_t))
+            return 0;
+
+        auto size = sizeof(std::uint16_t) + LoadBigEndian<std::uint16_t>(buffer.data());
+        return buffer.size() >= size ? size : 0;
+    }
+
+    static ValueType Get(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return std::string_view(reinterpret_cast<const char*>(buffer.data() + sizeof(std::uint16_t)),
+                                LoadBigEndian<std::uint16_t>(buffer.data()));
+    }
+};
+
+template <>
+struct Ocp1ViewElement<std::vector<std::uint8_t>>
+{
+    using ValueType = std::span<const std::uint8_t>;
+
+    static std::size_t Measure(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return Ocp1ViewElement<std::string>::Measure(buffer);
+    }
+
+    static ValueType Get(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return buffer.subspan(sizeof(std::uint16_t), LoadBigEndian<std::uint16_t>(buffer.data()));
+    }
+};
+
+template <>
+struct Ocp1ViewElement<Ocp1BitStringView>
+{
+    using ValueType = Ocp1BitStringView;
+
+    static std::size_t Measure(std::span<const std::uint8_t> buffer) noexcept
+    {
+        ValueType value;
+        return Ocp1Codec<Ocp1BitStringView>::Decode(buffer, value);
+    }
+
+    static ValueType Get(std::span<const std::uint8_t> buffer) noexcept
+    {
+        ValueType value;
+        Ocp1Codec<Ocp1BitStringView>::Decode(buffer, value);
+        return value;
+    }
+};
+
+
+//==============================================================================
+/**
+ * Read-only view of a marshaled OcaList<T>, i.e. a 16-bit element count followed by the elements.
+ *
+ * The complete list is validated once on construction. Iterating it afterwards decodes the
+ * elements in place, without allocating and without further bounds checks, e.g.
+ *
+ *     Ocp1ListView<std::string> names(parameterData);
+ *     for (std::string_view name : names)
+ *         ...
+ *
+ * The view does not own the bytes and is only valid as long as they are.
+ */
+template <typename T>
+class Ocp1ListView
+{
+public:
+    using Element = Ocp1ViewElement<T>;
+    using ValueType = typename Element::ValueType;
+
+    //==============================================================================
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = ValueType;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = ValueType;
+
+        Iterator() = default;
+
+        ValueType operator*() const noexcept
+        {
+            return Element::Get(m_remaining);
+        }
+
+        Iterator& operator++() noexcept
+        {
+            m_remaining = m_remaining.subspan(Element::Measure(m_remaining));
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            auto ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return m_remaining.data() == other.m_remaining.data();
+        }
+
+    private:
+        friend class Ocp1ListView;
+
+        explicit Iterator(std::span<const std::uint8_t> remaining) noexcept
+            : m_remaining(remaining)
+        {
+        }
+
+        std::span<const std::uint8_t> m_remaining;
+    };
+
+    //==============================================================================
+    Ocp1ListView() = default;
+
+    /**
+     * Validates the list at the start of the given buffer. Trailing bytes are ignored,
+     * getByteSize() tells where they start.
+     *
+     * @param[in] buffer    Bytes starting with the marshaled list.
+     * @param[in] pOk       Optional parameter to verify if the list was complete.
+     */
+    explicit Ocp1ListView(std::span<const std::uint8_t> buffer, bool* pOk = nullptr) noexcept
+    {
+        bool ok = (buffer.size() >= sizeof(std::uint16_t));
+        if (ok)
+        {
+            auto count = LoadBigEndian<std::uint16_t>(buffer.data());
+            auto elements = buffer.subspan(sizeof(std::uint16_t));
+
+            std::size_t elementsSize = 0;
+            if constexpr (requires { Element::Size; })
+            {
+                elementsSize = count * Element::Size;
+                ok = (elements.size() >= elementsSize);
+            }
+            else
+            {
+                for (std::size_t i = 0; ok && i < count; i++)
+                {
+                    auto size = Element::Measure(elements.subspan(elementsSize));
+                    elementsSize += size;
+                    ok = (size > 0);
+                }
+            }
+
+            if (ok)
+            {
+                m_elements = elements.first(elementsSize);
+                m_count = count;
+            }
+        }
+
+        if (pOk != nullptr)
+            *pOk = ok;
+    }
+
+    /**
+     * @return  The number of elements, 0 if the list was incomplete.
+     */
+    std::size_t size() const noexcept { return m_count; }
+    bool empty() const noexcept { return m_count == 0; }
+
+    /**
+     * @return  The number of bytes the marshaled list occupies, 0 if it was incomplete.
+     */
+    std::size_t getByteSize() const noexcept
+    {
+        return m_elements.data() != nullptr ? sizeof(std::uint16_t) + m_elements.size() : 0;
+    }
+
+    Iterator begin() const noexcept { return Iterator(m_elements); }
+    Iterator end() const noexcept { return Iterator(m_elements.last(0)); }
+
+    /**
+     * Random access, only available for elements of fixed size.
+     */
+    ValueType operator[](std::size_t index) const noexcept
+        requires requires { Element::Size; }
+    {
+        return Element::Get(m_elements.subspan(index * Element::Size, Element::Size));
+    }
+
+    /**
+     * Copies the elements into a std::vector, e.g. std::vector<std::string> for a list of strings.
+     */
+    template <typename U = T>
+    std::vector<U> toVector() const
+    {
+        std::vector<U> ret;
+        ret.reserve(m_count);
+        for (auto value : *this)
+            ret.emplace_back(value);
+
+        return ret;
+    }
+
+private:
+    std::span<const std::uint8_t>   m_elements;     // Marshaled elements without the count.
+    std::size_t                     m_count{ 0 };
+};
+
+/**
+ * Nested lists are yielded as views as well.
+ */
+template <typename T>
+struct Ocp1ViewElement<Ocp1ListView<T>>
+{
+    using ValueType = Ocp1ListView<T>;
+
+    static std::size_t Measure(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return ValueType(buffer).getByteSize();
+    }
+
+    static ValueType Get(std::span<const std::uint8_t> buffer) noexcept
+    {
+        return ValueType(buffer);
+    }
+};
+
+
+//==============================================================================
+/**
+ * Read-only view of a marshaled OcaMap<K, V>, i.e. a 16-bit entry count followed by
+ * the entries, each a key followed by its value.
+ *
+ * Like Ocp1ListView, the complete map is validated once on construction, after which
+ * iterating it yields std::pair<KeyType, MappedType> decoded in place.
+ * The view does not own the bytes and is only valid as long as they are.
+ */
+template <typename K, typename V>
+class Ocp1MapView
+{
+public:
+    using KeyElement = Ocp1ViewElement<K>;
+    using MappedElement = Ocp1ViewElement<V>;
+    using KeyType = typename KeyElement::ValueType;
+    using MappedType = typename MappedElement::ValueType;
+    using ValueType = std::pair<KeyType, MappedType>;
+
+    //==============================================================================
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = ValueType;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = ValueType;
+
+        Iterator() = default;
+
+        ValueType operator*() const noexcept
+        {
+            auto keySize = KeyElement::Measure(m_remaining);
+            return ValueType(KeyElement::Get(m_remaining), MappedElement::Get(m_remaining.subspan(keySize)));
+        }
+
+        Iterator& operator++() noexcept
+        {
+            auto keySize = KeyElement::Measure(m_remaining);
+            m_remaining = m_remaining.subspan(keySize + MappedElement::Measure(m_remaining.subspan(keySize)));
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            auto ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return m_remaining.data() == other.m_remaining.data();
+        }
+
+    private:
+        friend class Ocp1MapView;
+
+        explicit Iterator(std::span<const std::uint8_t> remaining) noexcept
+            : m_remaining(remaining)
+        {
+        }
+
+        std::span<const std::uint8_t> m_remaining;
+    };
+
+    //==============================================================================
+    Ocp1MapView() = default;
+
+    /**
+     * Validates the map at the start of the given buffer. Trailing bytes are ignored,
+     * getByteSize() tells where they start.
+     *
+     * @param[in] buffer    Bytes starting with the marshaled map.
+     * @param[in] pOk       Optional parameter to verify if the map was complete.
+     */
+    explicit Ocp1MapView(std::span<const std::uint8_t> buffer, bool* pOk = nullptr) noexcept
+    {
+        bool ok = (buffer.size() >= sizeof(std::uint16_t));
+        if (ok)
+        {
+            auto count = LoadBigEndian<std::uint16_t>(buffer.data());
+            auto entries = buffer.subspan(sizeof(std::uint16_t));
+
+            std::size_t entriesSize = 0;
+            if constexpr (requires { KeyElement::Size; MappedElement::Size; })
+            {
+                entriesSize = count * (KeyElement::Size + MappedElement::Size);
+                ok = (entries.size() >= entriesSize);
+            }
+            else
+            {
+                for (std::size_t i = 0; ok && i < count; i++)
+                {
+                    auto keySize = KeyElement::Measure(entries.subspan(entriesSize));
+                    auto mappedSize = (keySize > 0) ? MappedElement::Measure(entries.subspan(entriesSize + keySize)) : 0;
+                    entriesSize += keySize + mappedSize;
+                    ok = (mappedSize > 0);
+                }
+            }
+
+            if (ok)
+            {
+                m_entries = entries.first(entriesSize);
+                m_count = count;
+            }
+        }
+
+        if (pOk != nullptr)
+            *pOk = ok;
+    }
+
+    /**
+     * @return  The number of entries, 0 if the map was incomplete.
+     */
+    std::size_t size() const noexcept { return m_count; }
+    bool empty() const noexcept { return m_count == 0; }
+
+    /**
+     * @return  The number of bytes the marshaled map occupies, 0 if it was incomplete.
+     */
+    std::size_t getByteSize() const noexcept
+    {
+        return m_entries.data() != nullptr ? sizeof(std::uint16_t) + m_entries.size() : 0;
+    }
+
+    Iterator begin() const noexcept { return Iterator(m_entries); }
+    Iterator end() const noexcept { return Iterator(m_entries.last(0)); }
+
+    /**
+     * Linear search for the first entry with the given key.
+     *
+     * @return  Iterator to the entry, or end() if there is none.
+     */
+    template <typename Key>
+    Iterator find(const Key& key) const
+    {
+        auto iter = begin();
+        for (; iter != end(); ++iter)
+            if (KeyElement::Get(iter.m_remaining) == key)
+                break;
+
+        return iter;
+    }
+
+private:
+    std::span<const std::uint8_t>   m_entries;      // Marshaled entries without the count.
+    std::size_t                     m_count{ 0 };
+};
+
+}
@@ -17,6 +17,7 @@
  */
 
 #include "Ocp1Message.h"
+#include "Ocp1Metrics.h"
 
 #ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
     #include <juce_core/juce_core.h>
@@ -29,6 +30,28 @@
 namespace NanoOcp1
 {
 
+namespace
+{
+
+/**
+ * Writes the given value in network byte order and advances the write position.
+ */
+template <typename T>
+void Write(std::uint8_t*& out, T value)
+{
+    StoreBigEndian(out, value);
+    out += sizeof(T);
+}
+
+void Write(std::uint8_t*& out, const std::vector<std::uint8_t>& data)
+{
+    if (!data.empty())
+        std::memcpy(out, data.data(), data.size());
+    out += data.size();
+}
+
+}
+
 //==============================================================================
 // Class Ocp1CommandDefinition
 //==============================================================================
@@ -120,22 +143,27 @@ bool Ocp1Header::IsValid() const
 
 std::vector<std::uint8_t> Ocp1Header::GetSerializedData() const
 {
-    std::vector<std::uint8_t> serializedData;
-
-    serializedData.push_back(m_syncVal);
-    serializedData.push_back(static_cast<std::uint8_t>(m_protoVers >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_protoVers));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize));
-    serializedData.push_back(m_msgType);
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgCnt >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgCnt));
+    std::vector<std::uint8_t> serializedData(Ocp1HeaderSize);
+    SerializeTo(serializedData);
 
     return serializedData;
 }
 
+std::size_t Ocp1Header::SerializeTo(std::span<std::uint8_t> buffer) const
+{
+    if (buffer.size() < Ocp1HeaderSize)
+        return 0;
+
+    auto* out = buffer.data();
+    Write(out, m_syncVal);
+    Write(out, m_protoVers);
+    Write(out, m_msgSize);
+    Write(out, m_msgType);
+    Write(out, m_msgCnt);
+
+    return Ocp1HeaderSize;
+}
+
 std::uint32_t Ocp1Header::CalculateMessageSize(std::uint8_t msgType, size_t parameterDataLength)
 {
     std::uint32_t ret(0);
@@ -170,171 +198,199 @@ std::uint32_t Ocp1Header::CalculateMessageSize(std::uint8_t msgType, size_t para
 // OCA_INVALID_SESSIONID  == 0, OCA_LOCAL_SESSIONID == 1
 std::uint32_t Ocp1Message::m_nextHandle = 2;
 
+std::vector<std::uint8_t> Ocp1Message::GetSerializedData()
+{
+    std::vector<std::uint8_t> serializedData(GetSerializedSize());
+    SerializeTo(serializedData);
+
+    return serializedData;
+}
+
+std::size_t Ocp1Message::AppendTo(std::vector<std::uint8_t>& data) const
+{
+    auto offset = data.size();
+    data.resize(offset + GetSerializedSize());
+
+    return SerializeTo(std::span<std::uint8_t>(data).subspan(offset));
+}
+
 ByteVector Ocp1Message::GetMemoryBlock()
 {
     return GetSerializedData();
 }
 
 
-std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const std::vector<std::uint8_t>& receivedData)
+std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const std::vector<std::uint8_t>& receivedData, Ocp1Metrics* pMetrics)
 {
-    Ocp1Header header(receivedData);
-    if (!header.IsValid())
+    return UnmarshalOcp1Message(std::span<const std::uint8_t>(receivedData), nullptr, pMetrics);
+}
+
+std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(std::span<const std::uint8_t> receivedData, UnmarshalError* pError, Ocp1Metrics* pMetrics)
+{
+    using DecodeFailure = Ocp1Metrics::DecodeFailure;
+
+    auto failed = [pError, pMetrics](UnmarshalError error, DecodeFailure reason) -> std::unique_ptr<Ocp1Message> {
+        if (pError != nullptr)
+            *pError = error;
+        if (pMetrics != nullptr)
+            pMetrics->decodeFailed(reason);
         return nullptr;
-    
-    switch (header.GetMessageType())
+    };
+
+    if (pError != nullptr)
+        *pError = UnmarshalError::None;
+
+    constexpr std::size_t headerSize = Ocp1Header::Ocp1HeaderSize;
+    if (receivedData.size() < headerSize)
+        return failed(UnmarshalError::Truncated, DecodeFailure::Truncated);
+
+    const auto* data = receivedData.data();
+
+    const auto msgSize = LoadBigEndian<std::uint32_t>(data + 3);
+    const auto msgType = data[7];
+    if (data[0] != 0x3b ||                                  // Sync byte
+        LoadBigEndian<std::uint16_t>(data + 1) != 1 ||      // Protocol version
+        msgSize < headerSize ||
+        msgType > KeepAlive ||
+        LoadBigEndian<std::uint16_t>(data + 8) == 0)        // Message count
+        return failed(UnmarshalError::InvalidHeader, DecodeFailure::InvalidHeader);
+
+    // The message size does not include the sync byte. All bounds below are checked against
+    // frameSize, which is known to be available, so reading the fields needs no further checks.
+    const std::size_t frameSize = static_cast<std::size_t>(msgSize) + 1;
+    if (receivedData.size() < frameSize)
+        return failed(UnmarshalError::Truncated, DecodeFailure::Truncated);
+
+    switch (msgType)
     {
         case Notification:
             {
-                std::uint32_t notificationSize(ReadUint32(receivedData.data() + 10));
-                std::uint32_t newValueSize = notificationSize - 28;
-                if (newValueSize < 1)
-                    return nullptr;
-
-                // Not a valid object number.
-                std::uint32_t targetOno(ReadUint32(receivedData.data() + 14));
-                if (targetOno == 0)
-                    return nullptr;
-
-                // Method DefinitionLevel expected to be 3 (OcaSubscriptionManager)
-                std::uint16_t methodDefLevel(ReadUint16(receivedData.data() + 18));
-                if (methodDefLevel < 1)
-                    return nullptr;
-
-                // Method index expected to be 1 (AddSubscription)
-                std::uint16_t methodIdx(ReadUint16(receivedData.data() + 20));
-                if (methodIdx < 1)
-                    return nullptr;
-
-                // At least one parameter expected.
-                std::uint8_t paramCount = receivedData[22];
-                if (paramCount < 1)
-                    return nullptr;
-
-                std::uint16_t contextSize(ReadUint16(receivedData.data() + 23));
-
-                // Not a valid object number.
-                std::uint32_t emitterOno(ReadUint32(receivedData.data() + 25 + contextSize));
-                if (emitterOno == 0)
-                    return nullptr;
-
-                // Event definiton level expected to be 1 (OcaRoot).
-                std::uint16_t eventDefLevel(ReadUint16(receivedData.data() + 29 + contextSize));
-                if (eventDefLevel != 1)
-                    return nullptr;
-
-                // Event index expected to be 1 (OCA_EVENT_PROPERTY_CHANGED).
-                std::uint16_t eventIdx(ReadUint16(receivedData.data() + 31 + contextSize));
-                if (eventIdx != 1)
-                    return nullptr;
-
-                // Property definition level expected to be > 0.
-                std::uint16_t propDefLevel(ReadUint16(receivedData.data() + 33 + contextSize));
-                if (propDefLevel == 0)
-                    return nullptr;
-
-                // Property index expected to be > 0.
-                std::uint16_t propIdx(ReadUint16(receivedData.data() + 35 + contextSize));
-                if (propIdx == 0)
-                    return nullptr;
-
-                const auto parameterData = std::vector<std::uint8_t>(receivedData.begin() + 37 + contextSize, 
-                                                                     receivedData.begin() + 37 + contextSize + newValueSize);
-
-                return std::make_unique<Ocp1Notification>(emitterOno, propDefLevel, propIdx, paramCount, parameterData);
+                // Notification size, target ONo, method, param count and context size precede the context.
+                constexpr std::size_t contextOffset = headerSize + 15;
+                if (frameSize < contextOffset)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidNotification);
+
+                const auto notificationSize = LoadBigEndian<std::uint32_t>(data + headerSize);
+                const auto contextSize = LoadBigEndian<std::uint16_t>(data + contextOffset - 2);
+                const std::size_t eventOffset = contextOffset + contextSize;
+                const std::size_t valueOffset = eventOffset + 12; // Emitter ONo, event and property IDs.
+
+                // The notification size covers everything up to the value, at least one byte of value and the ending byte.
+                if (notificationSize < valueOffset - headerSize + 2 || notificationSize > frameSize - headerSize)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidNotification);
+
+                const std::size_t valueSize = notificationSize - (valueOffset - headerSize) - 1;
+
+                const auto targetOno = LoadBigEndian<std::uint32_t>(data + 14);
+                const auto methodDefLevel = LoadBigEndian<std::uint16_t>(data + 18);
+                const auto methodIdx = LoadBigEndian<std::uint16_t>(data + 20);
+                const auto paramCount = data[22];
+                const auto emitterOno = LoadBigEndian<std::uint32_t>(data + eventOffset);
+                const auto eventDefLevel = LoadBigEndian<std::uint16_t>(data + eventOffset + 4);
+                const auto eventIdx = LoadBigEndian<std::uint16_t>(data + eventOffset + 6);
+                const auto propDefLevel = LoadBigEndian<std::uint16_t>(data + eventOffset + 8);
+                const auto propIdx = LoadBigEndian<std::uint16_t>(data + eventOffset + 10);
+
+                // One combined check for all fields, the reason is only looked for if it fails.
+                // The event is expected to be OCA_EVENT_PROPERTY_CHANGED (1) on OcaRoot level (1).
+                if (targetOno == 0 || methodDefLevel == 0 || methodIdx == 0 || paramCount == 0 || emitterOno == 0 ||
+                    eventDefLevel != 1 || eventIdx != 1 || propDefLevel == 0 || propIdx == 0)
+                {
+                    auto error = (targetOno == 0 || emitterOno == 0)        ? UnmarshalError::InvalidObjectNumber
+                               : (methodDefLevel == 0 || methodIdx == 0)    ? UnmarshalError::InvalidMethod
+                               : (paramCount == 0)                          ? UnmarshalError::InvalidParamCount
+                               : (eventDefLevel != 1 || eventIdx != 1)      ? UnmarshalError::InvalidEvent
+                                                                            : UnmarshalError::InvalidProperty;
+                    return failed(error, DecodeFailure::InvalidNotification);
+                }
+
+                return std::make_unique<Ocp1Notification>(emitterOno, propDefLevel, propIdx, paramCount,
+                                                          std::vector<std::uint8_t>(data + valueOffset, data + valueOffset + valueSize));
             }
 
         case Response:
             {
-                std::uint32_t responseSize(ReadUint32(receivedData.data() + 10));
-                std::uint32_t parameterDataLength = responseSize - 10;
-                if (responseSize < 10)
-                    return nullptr;
+                // Response size, handle, status and param count precede the parameters.
+                constexpr std::size_t parameterDataOffset = headerSize + 10;
+                if (frameSize < parameterDataOffset)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidResponse);
 
-                // Not a valid handle.
-                std::uint32_t handle(ReadUint32(receivedData.data() + 14));
-                if (handle == 0)
-                    return nullptr;
+                const auto responseSize = LoadBigEndian<std::uint32_t>(data + headerSize);
+                if (responseSize < parameterDataOffset - headerSize || responseSize > frameSize - headerSize)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidResponse);
 
-                const std::uint8_t status = receivedData[18];
-                const std::uint8_t paramCount = receivedData[19];
+                const auto handle = LoadBigEndian<std::uint32_t>(data + 14);
+                if (handle == 0)
+                    return failed(UnmarshalError::InvalidHandle, DecodeFailure::InvalidResponse);
 
-                const auto parameterData = [&receivedData, &parameterDataLength]() {
-                    if (parameterDataLength == 0)
-                        return std::vector<std::uint8_t>{};
-                    else
-                        return std::vector<std::uint8_t>(receivedData.begin() + 20, receivedData.end());
-                    }();
-                jassert(parameterData.size() == parameterDataLength);
+                const auto status = data[18];
+                const auto paramCount = data[19];
 
-                return std::make_unique<Ocp1Response>(handle, status, paramCount, parameterData);
+                return std::make_unique<Ocp1Response>(handle, status, paramCount,
+                                                      std::vector<std::uint8_t>(data + parameterDataOffset, data + headerSize + responseSize));
             }
 
         case KeepAlive:
             {
-                std::uint16_t heartbeat(ReadUint16(receivedData.data() + 10));
+                // The heartbeat is either given as 16bit seconds or as 32bit milliseconds value.
+                if (msgSize == Ocp1Header::CalculateMessageSize(KeepAlive, sizeof(std::uint32_t)))
+                    return std::make_unique<Ocp1KeepAlive>(LoadBigEndian<std::uint32_t>(data + headerSize));
+
+                if (frameSize < headerSize + sizeof(std::uint16_t))
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidKeepAlive);
 
-                return std::make_unique<Ocp1KeepAlive>(heartbeat);
+                return std::make_unique<Ocp1KeepAlive>(LoadBigEndian<std::uint16_t>(data + headerSize));
             }
 
         case Command:
             {
                 // Not used in this implementation. See CommandResponseRequired instead.
+                if (pError != nullptr)
+                    *pError = UnmarshalError::UnsupportedType;
                 return nullptr;
             }
+
         case CommandResponseRequired:
             {
-                constexpr std::size_t commandSizeOffset = Ocp1Header::Ocp1HeaderSize;
+                constexpr std::size_t commandSizeOffset = headerSize;
                 constexpr std::size_t handleOffset = commandSizeOffset + 4;
                 constexpr std::size_t targetOnoOffset = handleOffset + 4;
                 constexpr std::size_t methodDefLevelOffset = targetOnoOffset + 4;
                 constexpr std::size_t methodIdxOffset = methodDefLevelOffset + 2;
                 constexpr std::size_t paramCountOffset = methodIdxOffset + 2;
-                constexpr std::uint32_t minimumCommandSize = 16; // Size without parameters
                 constexpr std::size_t parameterDataOffset = paramCountOffset + 1;
-
-                const std::uint32_t commandSize(ReadUint32(receivedData.data() + commandSizeOffset));
-                if (commandSize < minimumCommandSize)
-                    return nullptr;
-
-                if(receivedData.size() < Ocp1Header::Ocp1HeaderSize + commandSize)
-                    return nullptr;
-
-                std::uint32_t handle(ReadUint32(receivedData.data() + handleOffset));
-                const bool isInvalidHandle = (handle == 0);
-                if (isInvalidHandle)
-                    return nullptr;
-
-                const std::uint32_t targetOno(ReadUint32(receivedData.data() + targetOnoOffset));
-                const bool isInvalidTargetOno = (targetOno == 0);
-                if (isInvalidTargetOno)
-                    return nullptr;
-
-                const std::uint16_t methodDefLevel(ReadUint16(receivedData.data() + methodDefLevelOffset));
-                const bool isInvalidMethodDefLevel = (methodDefLevel < 1);
-                if (isInvalidMethodDefLevel)
-                    return nullptr;
-
-                const std::uint16_t methodIdx(ReadUint16(receivedData.data() + methodIdxOffset));
-                const bool isInvalidMethodIdx = (methodIdx < 1);
-                if (isInvalidMethodIdx)
-                    return nullptr;
-
-                const std::uint8_t paramCount = receivedData[paramCountOffset];
-                
-                const auto parameterData = [&receivedData, &paramCount, &parameterDataOffset]() {
-                    if (paramCount == 0)
-                        return std::vector<std::uint8_t>{};
-                    else if(receivedData.begin() + parameterDataOffset >= receivedData.end())
-                        return std::vector<std::uint8_t>{};
-                    else
-                        return std::vector<std::uint8_t>(receivedData.begin() + parameterDataOffset, receivedData.end());
-                }();
-
-                auto result = std::make_unique<Ocp1CommandResponseRequired>(targetOno, methodDefLevel, methodIdx, paramCount, parameterData);
+                constexpr std::uint32_t minimumCommandSize = parameterDataOffset - commandSizeOffset; // Size without parameters
+
+                if (frameSize < parameterDataOffset)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidCommand);
+
+                const auto commandSize = LoadBigEndian<std::uint32_t>(data + commandSizeOffset);
+                if (commandSize < minimumCommandSize || commandSize > frameSize - headerSize)
+                    return failed(UnmarshalError::InvalidSize, DecodeFailure::InvalidCommand);
+
+                const auto handle = LoadBigEndian<std::uint32_t>(data + handleOffset);
+                const auto targetOno = LoadBigEndian<std::uint32_t>(data + targetOnoOffset);
+                const auto methodDefLevel = LoadBigEndian<std::uint16_t>(data + methodDefLevelOffset);
+                const auto methodIdx = LoadBigEndian<std::uint16_t>(data + methodIdxOffset);
+                const auto paramCount = data[paramCountOffset];
+
+                if (handle == 0 || targetOno == 0 || methodDefLevel == 0 || methodIdx == 0)
+                {
+                    auto error = (handle == 0)      ? UnmarshalError::InvalidHandle
+                               : (targetOno == 0)   ? UnmarshalError::InvalidObjectNumber
+                                                    : UnmarshalError::InvalidMethod;
+                    return failed(error, DecodeFailure::InvalidCommand);
+                }
+
+                auto parameterData = (paramCount == 0)
+                    ? std::vector<std::uint8_t>{}
+                    : std::vector<std::uint8_t>(data + parameterDataOffset, data + commandSizeOffset + commandSize);
+
+                auto result = std::make_unique<Ocp1CommandResponseRequired>(targetOno, methodDefLevel, methodIdx, paramCount, std::move(parameterData));
                 result->SetHandle(handle);
                 return result;
             }
+
         default:
             return nullptr;
     }
@@ -346,34 +402,25 @@ std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const std::vector
 // Class Ocp1CommandResponseRequired
 //==============================================================================
 
-std::vector<std::uint8_t> Ocp1CommandResponseRequired::GetSerializedData()
+std::size_t Ocp1CommandResponseRequired::SerializeTo(std::span<std::uint8_t> buffer) const
 {
-    std::vector<std::uint8_t> serializedData = m_header.GetSerializedData();
+    auto serializedSize = GetSerializedSize();
+    if (buffer.size() < serializedSize)
+        return 0;
 
-    std::uint32_t commandSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodDefLevel));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodIndex >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodIndex));
-    serializedData.push_back(static_cast<std::uint8_t>(m_paramCount));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
+    auto* out = buffer.data() + m_header.SerializeTo(buffer);
 
-    return serializedData;
+    std::uint32_t commandSize(m_header.GetMessageSize() - 9); // Message size minus the header
+    Write(out, commandSize);
+    Write(out, m_handle);
+    Write(out, m_targetOno);
+    Write(out, m_methodDefLevel);
+    Write(out, m_methodIndex);
+    Write(out, m_paramCount);
+    Write(out, m_parameterData);
+
+    jassert(out == buffer.data() + serializedSize);
+    return serializedSize;
 }
 
 
@@ -382,27 +429,23 @@ std::vector<std::uint8_t> Ocp1CommandResponseRequired::GetSerializedData()
 // Class Ocp1Response
 //==============================================================================
 
-std::vector<std::uint8_t> Ocp1Response::GetSerializedData()
+std::size_t Ocp1Response::SerializeTo(std::span<std::uint8_t> buffer) const
 {
-    std::vector<std::uint8_t> serializedData = m_header.GetSerializedData();
+    auto serializedSize = GetSerializedSize();
+    if (buffer.size() < serializedSize)
+        return 0;
 
-    std::uint32_t responseSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle));
-    serializedData.push_back(static_cast<std::uint8_t>(m_status));
-    serializedData.push_back(static_cast<std::uint8_t>(m_paramCount));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
+    auto* out = buffer.data() + m_header.SerializeTo(buffer);
 
-    return serializedData;
+    std::uint32_t responseSize(m_header.GetMessageSize() - 9); // Message size minus the header
+    Write(out, responseSize);
+    Write(out, m_handle);
+    Write(out, m_status);
+    Write(out, m_paramCount);
+    Write(out, m_parameterData);
+
+    jassert(out == buffer.data() + serializedSize);
+    return serializedSize;
 }
 
 
@@ -411,51 +454,31 @@ std::vector<std::uint8_t> Ocp1Response::GetSerializedData()
 // Class Ocp1Notification
 //==============================================================================
 
-std::vector<std::uint8_t> Ocp1Notification::GetSerializedData()
+std::size_t Ocp1Notification::SerializeTo(std::span<std::uint8_t> buffer) const
 {
-    std::vector<std::uint8_t> serializedData = m_header.GetSerializedData();
+    auto serializedSize = GetSerializedSize();
+    if (buffer.size() < serializedSize)
+        return 0;
 
-    std::uint32_t notificationSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 24)); // TargetOno
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno));
-    std::uint16_t methodDefLevel = 3; // OcaSubscriptionManager
-    serializedData.push_back(static_cast<std::uint8_t>(methodDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(methodDefLevel));
-    std::uint16_t methodIdx = 1; // AddSubscription
-    serializedData.push_back(static_cast<std::uint8_t>(methodIdx >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(methodIdx));
-    std::uint16_t paramCount = 2;
-    serializedData.push_back(static_cast<std::uint8_t>(paramCount));
-    std::uint16_t contextLength = 0;
-    serializedData.push_back(static_cast<std::uint8_t>(contextLength >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(contextLength));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 24)); // EmitterOno
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno));
-    std::uint16_t eventDefLevel = 1; // OcaRoot level
-    serializedData.push_back(static_cast<std::uint8_t>(eventDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(eventDefLevel));
-    std::uint16_t eventIdx = 1; // PropertyChanged event
-    serializedData.push_back(static_cast<std::uint8_t>(eventIdx >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(eventIdx));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyDefLevel));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyIndex >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyIndex));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
-    serializedData.push_back(static_cast<std::uint8_t>(1)); // Ending byte
+    auto* out = buffer.data() + m_header.SerializeTo(buffer);
 
-    return serializedData;
+    std::uint32_t notificationSize(m_header.GetMessageSize() - 9); // Message size minus the header
+    Write(out, notificationSize);
+    Write(out, m_emitterOno);                       // TargetOno
+    Write(out, static_cast<std::uint16_t>(3));      // MethodDefLevel: OcaSubscriptionManager
+    Write(out, static_cast<std::uint16_t>(1));      // MethodIdx: AddSubscription
+    Write(out, static_cast<std::uint8_t>(2));       // ParamCount
+    Write(out, static_cast<std::uint16_t>(0));      // ContextLength
+    Write(out, m_emitterOno);                       // EmitterOno
+    Write(out, static_cast<std::uint16_t>(1));      // EventDefLevel: OcaRoot level
+    Write(out, static_cast<std::uint16_t>(1));      // EventIdx: PropertyChanged event
+    Write(out, m_emitterPropertyDefLevel);
+    Write(out, m_emitterPropertyIndex);
+    Write(out, m_parameterData);
+    Write(out, static_cast<std::uint8_t>(1));       // Ending byte
+
+    jassert(out == buffer.data() + serializedSize);
+    return serializedSize;
 }
 
 
@@ -496,12 +519,25 @@ std::uint32_t Ocp1KeepAlive::GetHeartBeatMilliseconds() const
     return 0;
 }
 
-std::vector<std::uint8_t> Ocp1KeepAlive::GetSerializedData()
+std::uint32_t Ocp1KeepAlive::GetHeartBeatTimeMs() const
 {
-    std::vector<std::uint8_t> serializedData = m_header.GetSerializedData();
-    serializedData.insert(serializedData.end(), m_parameterData.begin(), m_parameterData.end());
-    
-    return serializedData;
+    if (m_parameterData.size() == sizeof(std::uint32_t))
+        return GetHeartBeatMilliseconds();
+
+    return static_cast<std::uint32_t>(GetHeartBeatSeconds()) * 1000;
+}
+
+std::size_t Ocp1KeepAlive::SerializeTo(std::span<std::uint8_t> buffer) const
+{
+    auto serializedSize = GetSerializedSize();
+    if (buffer.size() < serializedSize)
+        return 0;
+
+    auto* out = buffer.data() + m_header.SerializeTo(buffer);
+    Write(out, m_parameterData);
+
+    jassert(out == buffer.data() + serializedSize);
+    return serializedSize;
 }
 
 }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "Variant.h"
 #include "Ocp1DataTypes.h" //< USE Ocp1DataType
@@ -34,6 +35,8 @@ namespace juce
 namespace NanoOcp1
 {
 
+class Ocp1Metrics;
+
 /**
  * Helper struct to encapsulate parameters for OCA Commands, Responses and Notifications.
  */
@@ -124,6 +127,17 @@ struct Ocp1CommandDefinition
         return static_cast<Ocp1DataType>(m_propertyType);
     }
 
+    /**
+     * Convenience getter method for the key uniquely identifying the property addressed by
+     * this Ocp1CommandDefinition (ONo, property definition level and property index).
+     *
+     * @return The property key as created by GetPropertyKey.
+     */
+    std::uint64_t GetPropertyKey() const
+    {
+        return NanoOcp1::GetPropertyKey(m_targetOno, m_propertyDefLevel, m_propertyIndex);
+    }
+
 
     std::uint32_t m_targetOno;                  // Target ONo of the command.
     std::uint16_t m_propertyType;               // Property type of the command, as a Ocp1DataType.
@@ -197,6 +211,14 @@ public:
      */
     std::vector<std::uint8_t> GetSerializedData() const;
 
+    /**
+     * Writes the binary contents of the header into the given buffer.
+     *
+     * @param[in] buffer    Buffer to write to, at least Ocp1HeaderSize bytes.
+     * @return  The number of bytes written, or 0 if the buffer is too small.
+     */
+    std::size_t SerializeTo(std::span<std::uint8_t> buffer) const;
+
     /**
      * Helper method to calculate the OCA message size based on the message's type and 
      * the number of parameter data bytes contained in the message.
@@ -239,12 +261,31 @@ public:
         KeepAlive = 4                   // KeepAlive message used for device supervision. 
     };
 
+    /**
+     * Reasons for UnmarshalOcp1Message to fail.
+     */
+    enum class UnmarshalError
+    {
+        None = 0,
+        InvalidHeader,          // Sync byte, protocol version, message size, type or count invalid.
+        Truncated,              // Fewer bytes than the header's message size.
+        InvalidSize,            // Size of the notification, response or command does not fit the message.
+        InvalidObjectNumber,    // Target or emitter ONo is 0.
+        InvalidHandle,          // Handle of a response or command is 0.
+        InvalidMethod,          // Method definition level or index is 0.
+        InvalidEvent,           // Notification is not a PropertyChanged event.
+        InvalidProperty,        // Property definition level or index is 0.
+        InvalidParamCount,      // Notification without parameters.
+        UnsupportedType         // Command without response, not used in this implementation.
+    };
+    static constexpr int UnmarshalErrorCount = static_cast<int>(UnmarshalError::UnsupportedType) + 1;
+
     /**
      * Class constructor.
      */
-    Ocp1Message(std::uint8_t msgType, const std::vector<std::uint8_t>& parameterData)
+    Ocp1Message(std::uint8_t msgType, std::vector<std::uint8_t> parameterData)
         : m_header(Ocp1Header(msgType, parameterData.size())),
-        m_parameterData(parameterData)
+        m_parameterData(std::move(parameterData))
 
     {
     }
@@ -276,11 +317,39 @@ public:
 
     /**
      * Returns a vector of bytes representing the binary contents of the complete message.
-     * Must be reimplemented for each message type.
      *
      * @return  A vector containing the OCA message including header.
      */
-    virtual std::vector<std::uint8_t> GetSerializedData() = 0;
+    virtual std::vector<std::uint8_t> GetSerializedData();
+
+    /**
+     * Gets the size of the binary contents of the complete message, i.e. the buffer size SerializeTo needs.
+     *
+     * @return  Size of the OCA message in bytes, including the initial sync byte.
+     */
+    std::size_t GetSerializedSize() const
+    {
+        return static_cast<std::size_t>(m_header.GetMessageSize()) + 1;
+    }
+
+    /**
+     * Writes the binary contents of the complete message into the given buffer, e.g. straight
+     * into send queue memory, without any intermediate allocations.
+     * Must be reimplemented for each message type.
+     *
+     * @param[in] buffer    Buffer to write to, at least GetSerializedSize bytes.
+     * @return  The number of bytes written, or 0 if the buffer is too small.
+     */
+    virtual std::size_t SerializeTo(std::span<std::uint8_t> buffer) const = 0;
+
+    /**
+     * Appends the binary contents of the complete message to the given vector,
+     * growing it at most once.
+     *
+     * @param[in] data  Vector to append to.
+     * @return  The number of bytes appended.
+     */
+    std::size_t AppendTo(std::vector<std::uint8_t>& data) const;
 
     /**
      * Convenience method which returns a juce::MemoryBloc representing 
@@ -295,9 +364,25 @@ public:
      * Factory method which creates a new Ocp1Message object based on a vector<std::uint8_t>.
      *
      * @param[in] receivedData    Vector containing the received OCA message.
+     * @param[in] pMetrics        Optional. Metrics to count decode failures into. Nothing is counted if nullptr.
      * @return  A unique pointer to the unmarshaled Ocp1Message object.
      */
-    static std::unique_ptr<Ocp1Message> UnmarshalOcp1Message(const std::vector<std::uint8_t>& receivedData);
+    static std::unique_ptr<Ocp1Message> UnmarshalOcp1Message(const std::vector<std::uint8_t>& receivedData, Ocp1Metrics* pMetrics = nullptr);
+
+    /**
+     * Factory method which creates a new Ocp1Message object based on the bytes of one received message.
+     *
+     * The complete message is validated against the header's message size and the size of
+     * the contained notification, response or command before any field is read, so truncated
+     * or malformed input can never cause reads beyond receivedData. Trailing bytes beyond
+     * the header's message size are ignored.
+     *
+     * @param[in] receivedData    Bytes of the received OCA message.
+     * @param[out] pError         Optional. Set to the reason if unmarshaling failed, to UnmarshalError::None otherwise.
+     * @param[in] pMetrics        Optional. Metrics to count decode failures into. Nothing is counted if nullptr.
+     * @return  A unique pointer to the unmarshaled Ocp1Message object, nullptr on failure.
+     */
+    static std::unique_ptr<Ocp1Message> UnmarshalOcp1Message(std::span<const std::uint8_t> receivedData, UnmarshalError* pError, Ocp1Metrics* pMetrics = nullptr);
 
 
 protected:
@@ -321,8 +406,8 @@ public:
                                 std::uint16_t methodDefLevel,
                                 std::uint16_t methodIndex,
                                 std::uint8_t paramCount,
-                                const std::vector<std::uint8_t>& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(CommandResponseRequired), parameterData),
+                                std::vector<std::uint8_t> parameterData)
+        : Ocp1Message(static_cast<std::uint8_t>(CommandResponseRequired), std::move(parameterData)),
             m_handle(0),
             m_targetOno(targetOno),
             m_methodDefLevel(methodDefLevel),
@@ -396,7 +481,7 @@ public:
     
     // Reimplemented from Ocp1Message
 
-    std::vector<std::uint8_t> GetSerializedData() override;
+    std::size_t SerializeTo(std::span<std::uint8_t> buffer) const override;
 
 protected:
     std::uint32_t               m_handle;           // Handle of the command.
@@ -419,8 +504,8 @@ public:
     Ocp1Response(std::uint32_t handle,
                  std::uint8_t status,
                  std::uint8_t paramCount,
-                 const std::vector<std::uint8_t>& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(Response), parameterData),
+                 std::vector<std::uint8_t> parameterData)
+        : Ocp1Message(static_cast<std::uint8_t>(Response), std::move(parameterData)),
             m_handle(handle),
             m_status(status),
             m_paramCount(paramCount)
@@ -464,7 +549,7 @@ public:
 
     // Reimplemented from Ocp1Message
 
-    std::vector<std::uint8_t> GetSerializedData() override;
+    std::size_t SerializeTo(std::span<std::uint8_t> buffer) const override;
 
 protected:
     /**
@@ -497,8 +582,8 @@ public:
                      std::uint16_t emitterPropertyDefLevel,
                      std::uint16_t emitterPropertyIndex,
                      std::uint8_t paramCount,
-                     const std::vector<std::uint8_t>& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(Notification), parameterData),
+                     std::vector<std::uint8_t> parameterData)
+        : Ocp1Message(static_cast<std::uint8_t>(Notification), std::move(parameterData)),
             m_emitterOno(emitterOno),
             m_emitterPropertyDefLevel(emitterPropertyDefLevel),
             m_emitterPropertyIndex(emitterPropertyIndex),
@@ -531,6 +616,16 @@ public:
         return m_paramCount;
     }
 
+    /**
+     * Gets the key uniquely identifying the property whose change triggered this notification.
+     *
+     * @return  The property key as created by GetPropertyKey.
+     */
+    std::uint64_t GetPropertyKey() const
+    {
+        return NanoOcp1::GetPropertyKey(m_emitterOno, m_emitterPropertyDefLevel, m_emitterPropertyIndex);
+    }
+
     /**
      * Helper method which matches this notification to a given object definition.
      * 
@@ -544,9 +639,75 @@ public:
                 (def->m_propertyIndex == m_emitterPropertyIndex));
     }
 
+    /**
+     * Walks the PropertyChanged notifications of a received notification PDU without unmarshalling them.
+     * Notifications of other events are skipped. Walking stops at the first malformed notification,
+     * the ones before it have already been visited.
+     *
+     * @param[in] receivedData  Serialized OCA message as received, including the header.
+     * @param[in] visit         Called as visit(propertyKey, value) for every PropertyChanged notification,
+     *                          value being a span over the property value bytes within receivedData.
+     * @return  True if the data is a well-formed notification PDU containing only PropertyChanged notifications.
+     */
+    template <typename Visitor>
+    static bool VisitPropertyChanges(std::span<const std::uint8_t> receivedData, Visitor&& visit)
+    {
+        constexpr std::size_t msgSizeOffset = 3;
+        constexpr std::size_t msgTypeOffset = 7;
+        constexpr std::size_t msgCountOffset = 8;
+        constexpr std::size_t contextSizeOffset = 13;           // Relative to the notification.
+        constexpr std::size_t emitterOnoOffset = 15;            // Relative to the notification, plus context size.
+        constexpr std::size_t eventDefLevelOffset = 19;         // Relative to the notification, plus context size.
+        constexpr std::size_t eventIndexOffset = 21;            // Relative to the notification, plus context size.
+        constexpr std::size_t propertyDefLevelOffset = 23;      // Relative to the notification, plus context size.
+        constexpr std::size_t propertyIndexOffset = 25;         // Relative to the notification, plus context size.
+        constexpr std::size_t valueOffset = 27;                 // Relative to the notification, plus context size.
+        constexpr std::size_t notificationOverhead = 28;        // Notification size not belonging to the context or value.
+
+        const auto* data = receivedData.data();
+        if (receivedData.size() < Ocp1Header::Ocp1HeaderSize || data[msgTypeOffset] != Notification)
+            return false;
+
+        const std::size_t frameSize = static_cast<std::size_t>(LoadBigEndian<std::uint32_t>(data + msgSizeOffset)) + 1;
+        const auto msgCount = LoadBigEndian<std::uint16_t>(data + msgCountOffset);
+        if (frameSize > receivedData.size() || msgCount == 0)
+            return false;
+
+        auto propertyChangesOnly = true;
+        std::size_t position = Ocp1Header::Ocp1HeaderSize;
+        for (std::uint16_t i = 0; i < msgCount; i++)
+        {
+            if (position + valueOffset > frameSize)
+                return false;
+
+            const auto* notification = data + position;
+            const std::size_t notificationSize = LoadBigEndian<std::uint32_t>(notification);
+            const std::size_t contextSize = LoadBigEndian<std::uint16_t>(notification + contextSizeOffset);
+            if (notificationSize < notificationOverhead + contextSize || notificationSize > frameSize - position)
+                return false;
+
+            // The event is expected to be OCA_EVENT_PROPERTY_CHANGED (1) on OcaRoot level (1).
+            if (LoadBigEndian<std::uint16_t>(notification + eventDefLevelOffset + contextSize) == 1 &&
+                LoadBigEndian<std::uint16_t>(notification + eventIndexOffset + contextSize) == 1)
+            {
+                const auto propertyKey = NanoOcp1::GetPropertyKey(LoadBigEndian<std::uint32_t>(notification + emitterOnoOffset + contextSize),
+                                                                  LoadBigEndian<std::uint16_t>(notification + propertyDefLevelOffset + contextSize),
+                                                                  LoadBigEndian<std::uint16_t>(notification + propertyIndexOffset + contextSize));
+                visit(propertyKey, std::span<const std::uint8_t>(notification + valueOffset + contextSize,
+                                                                 notificationSize - notificationOverhead - contextSize));
+            }
+            else
+                propertyChangesOnly = false;
+
+            position += notificationSize;
+        }
+
+        return propertyChangesOnly;
+    }
+
     // Reimplemented from Ocp1Message
 
-    std::vector<std::uint8_t> GetSerializedData() override;
+    std::size_t SerializeTo(std::span<std::uint8_t> buffer) const override;
 
 protected:
     std::uint32_t               m_emitterOno;               // ONo of the object whose property changed, triggering this notification.
@@ -593,10 +754,16 @@ public:
      */
     std::uint32_t GetHeartBeatMilliseconds() const;
 
+    /**
+     * Get this KeepAlive message's heartbeat time, regardless of the form used.
+     * @return This KeepAlive message's heartbeat time in milliseconds.
+     */
+    std::uint32_t GetHeartBeatTimeMs() const;
+
 
     // Reimplemented from Ocp1Message
 
-    std::vector<std::uint8_t> GetSerializedData() override;
+    std::size_t SerializeTo(std::span<std::uint8_t> buffer) const override;
 };
 
 }
@@ -0,0 +1,165 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Ocp1MeterAggregator.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1MeterAggregator::Ocp1MeterAggregator()
+{
+    for (auto& frame : m_frames)
+    {
+        for (auto& levels : frame.m_levels)
+            levels.fill(NoLevel);
+        frame.m_updatedChannels.fill(0);
+    }
+}
+
+Ocp1MeterAggregator::~Ocp1MeterAggregator()
+{
+}
+
+//==============================================================================
+bool Ocp1MeterAggregator::processReceivedData(const ByteVector& data)
+{
+    // All notifications of a PDU are decoded, the DS100 may well batch its meters.
+    auto metersOnly = true;
+    auto propertyChangesOnly = Ocp1Notification::VisitPropertyChanges(data, [this, &metersOnly](std::uint64_t propertyKey, std::span<const std::uint8_t> value) {
+        Bank bank;
+        int channel;
+        if (value.size() == sizeof(float) && IsMeterProperty(propertyKey, bank, channel))
+            setLevel(bank, channel, LoadBigEndian<float>(value.data()));
+        else
+            metersOnly = false;
+    });
+
+    return propertyChangesOnly && metersOnly;
+}
+
+void Ocp1MeterAggregator::setLevel(Bank bank, int channel, float level)
+{
+    if (channel < 1 || channel > ChannelCount)
+        return;
+
+    const auto bankIndex = static_cast<std::size_t>(bank);
+    const auto channelBit = std::uint64_t(1) << (channel - 1);
+
+    // The device notifies every meter once per metering cycle, so a meter that was
+    // already updated for the back frame means the next cycle has begun.
+    if ((m_frames[m_writeIndex].m_updatedChannels[bankIndex] & channelBit) != 0)
+        publish();
+
+    auto& frame = m_frames[m_writeIndex];
+    frame.m_levels[bankIndex][static_cast<std::size_t>(channel - 1)] = level;
+    frame.m_updatedChannels[bankIndex] |= channelBit;
+}
+
+void Ocp1MeterAggregator::publish()
+{
+    auto& frame = m_frames[m_writeIndex];
+    if (std::all_of(frame.m_updatedChannels.begin(), frame.m_updatedChannels.end(), [](auto updated) { return updated == 0; }))
+        return;
+
+    frame.m_frameNumber = m_frameCount.load(std::memory_order_relaxed) + 1;
+
+    const auto publishedIndex = m_writeIndex;
+    m_writeIndex = m_readyIndex.exchange(publishedIndex | NewFrameFlag, std::memory_order_acq_rel) & IndexMask;
+    m_frameCount.store(frame.m_frameNumber, std::memory_order_release);
+
+    // Meters not notified for the next frame keep their level. The consumer may be reading
+    // the published frame by now, but it never writes to it, so copying from it is safe.
+    auto& nextFrame = m_frames[m_writeIndex];
+    nextFrame.m_levels = frame.m_levels;
+    nextFrame.m_updatedChannels.fill(0);
+}
+
+//==============================================================================
+const Ocp1MeterAggregator::Frame& Ocp1MeterAggregator::getLatestFrame()
+{
+    if ((m_readyIndex.load(std::memory_order_relaxed) & NewFrameFlag) != 0)
+        m_readIndex = m_readyIndex.exchange(m_readIndex, std::memory_order_acq_rel) & IndexMask;
+
+    return m_frames[m_readIndex];
+}
+
+std::uint64_t Ocp1MeterAggregator::getPublishedFrameCount() const
+{
+    return m_frameCount.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+bool Ocp1MeterAggregator::IsMeterProperty(std::uint64_t propertyKey, Bank& bank, int& channel)
+{
+    constexpr std::uint16_t levelPropertyIndex = 1; // Prop_Level
+
+    const auto ono = static_cast<std::uint32_t>(propertyKey >> 32);
+    const auto propertyDefLevel = static_cast<std::uint16_t>(propertyKey >> 16);
+    const auto propertyIndex = static_cast<std::uint16_t>(propertyKey);
+    if (propertyDefLevel != DefLevel_OcaLevelSensor || propertyIndex != levelPropertyIndex)
+        return false;
+
+    // Inverse of GetONoTy2(0x02, 0x00, channel, box, object).
+    const auto type = ono >> 28;
+    const auto record = (ono >> 20) & 0xFF;
+    const auto ch = static_cast<int>((ono >> 12) & 0xFF);
+    const auto box = (ono >> 7) & 0x1F;
+    const auto object = ono & 0x7F;
+    if (type != 0x02 || record != 0x00 || ch < 1 || ch > ChannelCount)
+        return false;
+
+    int bankIndex;
+    if (box == DS100::MatrixInput_Box && object >= DS100::MatrixInput_LevelMeterIn && object <= DS100::MatrixInput_LevelMeterPostMute)
+        bankIndex = static_cast<int>(Bank::InputLevelIn) + static_cast<int>(object - DS100::MatrixInput_LevelMeterIn);
+    else if (box == DS100::MatrixOutput_Box && object >= DS100::MatrixOutput_LevelMeterIn && object <= DS100::MatrixOutput_LevelMeterPostMute)
+        bankIndex = static_cast<int>(Bank::OutputLevelIn) + static_cast<int>(object - DS100::MatrixOutput_LevelMeterIn);
+    else
+        return false;
+
+    bank = static_cast<Bank>(bankIndex);
+    channel = ch;
+
+    return true;
+}
+
+std::vector<std::unique_ptr<Ocp1CommandDefinition>> Ocp1MeterAggregator::CreateDefinitions()
+{
+    std::vector<std::unique_ptr<Ocp1CommandDefinition>> defs;
+    defs.reserve(BankCount * ChannelCount);
+
+    for (std::uint32_t channel = 1; channel <= ChannelCount; channel++)
+    {
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixInput_LevelMeterIn>(channel));
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixInput_LevelMeterPreMute>(channel));
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixInput_LevelMeterPostMute>(channel));
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixOutput_LevelMeterIn>(channel));
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixOutput_LevelMeterPreMute>(channel));
+        defs.push_back(std::make_unique<DS100::dbOcaObjectDef_MatrixOutput_LevelMeterPostMute>(channel));
+    }
+
+    return defs;
+}
+
+
+}
@@ -0,0 +1,169 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+struct Ocp1CommandDefinition;
+
+
+//==============================================================================
+/**
+    Aggregates the level meter notifications of a DS100 into frames of contiguous float arrays.
+
+    The DS100 matrix has a LevelMeterIn, LevelMeterPreMute and LevelMeterPostMute sensor
+    for each of its 64 inputs and 64 outputs. Instead of unmarshaling every notification
+    into its own message object, the levels are read from the raw received data and stored
+    in one array per bank, indexed by channel.
+
+    The arrays are triple buffered: the thread that delivers received data writes to the
+    back frame, publishing it is a single atomic exchange, and the consumer (i.e. a UI or
+    analysis thread) picks up the latest published frame with another one. Neither side
+    ever waits for the other, and the consumer always sees all banks of a frame together.
+    A frame is published when a meter is notified again that was already updated since the
+    last publish, i.e. once the device started its next metering cycle, or via publish().
+
+    There must be only one writing and one consuming thread.
+*/
+class Ocp1MeterAggregator
+{
+public:
+    /**
+     * The level meter banks of the DS100 matrix.
+     */
+    enum class Bank
+    {
+        InputLevelIn = 0,
+        InputPreMute,
+        InputPostMute,
+        OutputLevelIn,
+        OutputPreMute,
+        OutputPostMute
+    };
+    static constexpr int BankCount = 6;
+    static constexpr int ChannelCount = 64;
+
+    /**
+     * Level of meters that were never notified.
+     */
+    static constexpr float NoLevel = -std::numeric_limits<float>::infinity();
+
+    /**
+     * All meter levels at the time the frame was published.
+     */
+    struct Frame
+    {
+        using Levels = std::array<float, ChannelCount>;
+
+        std::array<Levels, BankCount>           m_levels;           // Per bank, indexed by channel - 1.
+        std::array<std::uint64_t, BankCount>    m_updatedChannels;  // Per bank, bit (channel - 1) set if notified for this frame.
+        std::uint64_t                           m_frameNumber{ 0 }; // 0 before the first frame was published.
+
+        const Levels& getLevels(Bank bank) const { return m_levels[static_cast<std::size_t>(bank)]; }
+        float getLevel(Bank bank, int channel) const { return getLevels(bank)[static_cast<std::size_t>(channel - 1)]; }
+    };
+
+public:
+    //==============================================================================
+    Ocp1MeterAggregator();
+    ~Ocp1MeterAggregator();
+
+    //==============================================================================
+    /**
+     * Stores the level of every meter notification contained in the given serialized message.
+     * To be called by the writing thread only.
+     *
+     * @param[in] data  Serialized OCA message as received.
+     * @return  True if the message was a notification PDU consisting of meter notifications only.
+     */
+    bool processReceivedData(const ByteVector& data);
+
+    /**
+     * Stores the level of a single meter.
+     * To be called by the writing thread only.
+     *
+     * @param[in] bank      Bank of the meter.
+     * @param[in] channel   Channel of the meter, starting at 1.
+     * @param[in] level     Level of the meter.
+     */
+    void setLevel(Bank bank, int channel, float level);
+
+    /**
+     * Publishes the back frame, if any meter was updated since the last publish.
+     * To be called by the writing thread only.
+     */
+    void publish();
+
+    //==============================================================================
+    /**
+     * Gets the most recently published frame.
+     * To be called by the consuming thread only.
+     *
+     * @return  The frame. It stays valid and unchanged until the next call.
+     */
+    const Frame& getLatestFrame();
+
+    /**
+     * Gets the number of frames published so far. Can be called on any thread.
+     */
+    std::uint64_t getPublishedFrameCount() const;
+
+    //==============================================================================
+    /**
+     * Checks whether the given property key belongs to a meter of one of the banks.
+     *
+     * @param[in] propertyKey   Key of the property, see GetPropertyKey.
+     * @param[out] bank         Set to the bank of the meter.
+     * @param[out] channel      Set to the channel of the meter, starting at 1.
+     * @return  True if the key belongs to a meter.
+     */
+    static bool IsMeterProperty(std::uint64_t propertyKey, Bank& bank, int& channel);
+
+    /**
+     * Creates the object definitions of all meters, for subscribing to them.
+     */
+    static std::vector<std::unique_ptr<Ocp1CommandDefinition>> CreateDefinitions();
+
+private:
+    //==============================================================================
+    static constexpr std::uint32_t IndexMask = 0x3;
+    static constexpr std::uint32_t NewFrameFlag = 0x4;
+
+    //==============================================================================
+    std::array<Frame, 3>            m_frames;
+    std::uint32_t                   m_writeIndex{ 0 };  // Owned by the writing thread.
+    std::uint32_t                   m_readIndex{ 2 };   // Owned by the consuming thread.
+    std::atomic<std::uint32_t>      m_readyIndex{ 1 };  // Index of the frame in between, plus NewFrameFlag if not picked up yet.
+    std::atomic<std::uint64_t>      m_frameCount{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1MeterAggregator)
+};
+
+}
@@ -0,0 +1,177 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1Metrics.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1Metrics::Ocp1Metrics(Ocp1Metrics* aggregate)
+    : m_aggregate(aggregate)
+{
+    jassert(m_aggregate != this);
+}
+
+Ocp1Metrics::~Ocp1Metrics()
+{
+    // Gauges of a connection that goes away must not linger in the aggregate.
+    if (m_aggregate != nullptr)
+    {
+        m_aggregate->add(Counter::SendQueueDepth, -get(Counter::SendQueueDepth));
+        m_aggregate->add(Counter::DeliveryQueueDepth, -get(Counter::DeliveryQueueDepth));
+    }
+}
+
+Ocp1Metrics& Ocp1Metrics::GetAggregate()
+{
+    static Ocp1Metrics aggregate(nullptr);
+    return aggregate;
+}
+
+//==============================================================================
+void Ocp1Metrics::add(Counter counter, std::int64_t delta)
+{
+    m_counters[static_cast<std::size_t>(counter)].fetch_add(delta, std::memory_order_relaxed);
+
+    if (m_aggregate != nullptr)
+        m_aggregate->add(counter, delta);
+}
+
+void Ocp1Metrics::decodeFailed(DecodeFailure reason)
+{
+    m_decodeFailures[static_cast<std::size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    m_counters[static_cast<std::size_t>(Counter::DecodeFailures)].fetch_add(1, std::memory_order_relaxed);
+
+    if (m_aggregate != nullptr)
+        m_aggregate->decodeFailed(reason);
+}
+
+std::int64_t Ocp1Metrics::get(Counter counter) const
+{
+    return m_counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+Ocp1Metrics::Snapshot Ocp1Metrics::getSnapshot() const
+{
+    Snapshot snapshot;
+
+    for (std::size_t i = 0; i < m_counters.size(); i++)
+        snapshot.m_counters[i] = m_counters[i].load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < m_decodeFailures.size(); i++)
+        snapshot.m_decodeFailures[i] = m_decodeFailures[i].load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+//==============================================================================
+juce::String Ocp1Metrics::toString(Format format, const juce::String& label) const
+{
+    const auto snapshot = getSnapshot();
+    auto isGauge = [](Counter counter) { return counter == Counter::SendQueueDepth || counter == Counter::DeliveryQueueDepth; };
+
+    juce::String text;
+
+    if (format == Format::Prometheus)
+    {
+        const auto labels = label.isEmpty() ? juce::String() : ("connection=\"" + label + "\"");
+
+        for (int i = 0; i < CounterCount; i++)
+        {
+            const auto counter = static_cast<Counter>(i);
+            if (counter == Counter::DecodeFailures)
+                continue; // Exported per reason below.
+
+            const auto name = juce::String("nanoocp1_") + GetCounterName(counter) + (isGauge(counter) ? "" : "_total");
+            text << "# TYPE " << name << (isGauge(counter) ? " gauge\n" : " counter\n");
+            text << name << (labels.isEmpty() ? juce::String() : ("{" + labels + "}")) << " " << juce::String(snapshot.get(counter)) << "\n";
+        }
+
+        text << "# TYPE nanoocp1_decode_failures_total counter\n";
+        for (int i = 0; i < DecodeFailureCount; i++)
+        {
+            const auto reason = static_cast<DecodeFailure>(i);
+            text << "nanoocp1_decode_failures_total{" << (labels.isEmpty() ? juce::String() : (labels + ","))
+                 << "reason=\"" << GetDecodeFailureName(reason) << "\"} " << juce::String(snapshot.get(reason)) << "\n";
+        }
+    }
+    else
+    {
+        juce::DynamicObject::Ptr json = new juce::DynamicObject();
+        if (label.isNotEmpty())
+            json->setProperty("connection", label);
+
+        for (int i = 0; i < CounterCount; i++)
+            json->setProperty(GetCounterName(static_cast<Counter>(i)), snapshot.get(static_cast<Counter>(i)));
+
+        juce::DynamicObject::Ptr decodeFailures = new juce::DynamicObject();
+        for (int i = 0; i < DecodeFailureCount; i++)
+            decodeFailures->setProperty(GetDecodeFailureName(static_cast<DecodeFailure>(i)), snapshot.get(static_cast<DecodeFailure>(i)));
+        json->setProperty("decode_failures_by_reason", juce::var(decodeFailures.get()));
+
+        text = juce::JSON::toString(juce::var(json.get()));
+    }
+
+    return text;
+}
+
+bool Ocp1Metrics::dumpToFile(const juce::File& file, Format format, const juce::String& label) const
+{
+    return file.replaceWithText(toString(format, label));
+}
+
+const char* Ocp1Metrics::GetCounterName(Counter counter)
+{
+    switch (counter)
+    {
+        case Counter::BytesIn:              return "bytes_in";
+        case Counter::BytesOut:             return "bytes_out";
+        case Counter::PdusIn:               return "pdus_in";
+        case Counter::PdusOut:              return "pdus_out";
+        case Counter::ConnectionsMade:      return "connections_made";
+        case Counter::ConnectionsLost:      return "connections_lost";
+        case Counter::ConnectionsAccepted:  return "connections_accepted";
+        case Counter::Reconnects:           return "reconnects";
+        case Counter::ReceiveTimeouts:      return "receive_timeouts";
+        case Counter::CommandTimeouts:      return "command_timeouts";
+        case Counter::SendQueueDepth:       return "send_queue_depth";
+        case Counter::DeliveryQueueDepth:   return "delivery_queue_depth";
+        case Counter::DecodeFailures:       return "decode_failures";
+        default:                            return "unknown";
+    }
+}
+
+const char* Ocp1Metrics::GetDecodeFailureName(DecodeFailure reason)
+{
+    switch (reason)
+    {
+        case DecodeFailure::InvalidHeader:          return "invalid_header";
+        case DecodeFailure::Truncated:              return "truncated";
+        case DecodeFailure::InvalidNotification:    return "invalid_notification";
+        case DecodeFailure::InvalidResponse:        return "invalid_response";
+        case DecodeFailure::InvalidKeepAlive:       return "invalid_keepalive";
+        case DecodeFailure::InvalidCommand:         return "invalid_command";
+        default:                                    return "unknown";
+    }
+}
+
+
+}
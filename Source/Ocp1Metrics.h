@@ -0,0 +1,148 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Registry of transport and codec counters.
+
+    Every Ocp1Connection owns an instance, and every instance forwards what it counts to
+    the process wide aggregate (see GetAggregate). Counting is a relaxed atomic add, so
+    it is cheap enough for the receive and send paths. Gauges, like queue depths, are
+    counted up and down and thus aggregate correctly as well.
+
+    A consistent view is obtained by pulling a Snapshot, which can be rendered as
+    Prometheus text exposition format or JSON and optionally dumped to a file.
+*/
+class Ocp1Metrics
+{
+public:
+    /**
+     * Counters and gauges kept by the registry.
+     */
+    enum class Counter
+    {
+        BytesIn = 0,            // Bytes received.
+        BytesOut,               // Bytes written to the socket.
+        PdusIn,                 // OCA messages received.
+        PdusOut,                // OCA messages written to the socket.
+        ConnectionsMade,        // Connections established, incoming or outgoing.
+        ConnectionsLost,        // Connections lost or closed.
+        ConnectionsAccepted,    // Incoming connections accepted by a Ocp1ConnectionServer.
+        Reconnects,             // Connections established again by a client that had lost its connection.
+        ReceiveTimeouts,        // Connections dropped since the peer went silent.
+        CommandTimeouts,        // Commands that did not get a response in time.
+        SendQueueDepth,         // Gauge: commands held back by the rate limiter.
+        DeliveryQueueDepth,     // Gauge: received messages waiting to be delivered on the message thread.
+        DecodeFailures          // Received messages that could not be decoded, see DecodeFailure for the reasons.
+    };
+    static constexpr int CounterCount = static_cast<int>(Counter::DecodeFailures) + 1;
+
+    /**
+     * Reasons for a received message not being decodable.
+     */
+    enum class DecodeFailure
+    {
+        InvalidHeader = 0,      // Sync byte, protocol version, size or message type invalid.
+        Truncated,              // Connection ended before the complete message was received.
+        InvalidNotification,
+        InvalidResponse,
+        InvalidKeepAlive,
+        InvalidCommand
+    };
+    static constexpr int DecodeFailureCount = static_cast<int>(DecodeFailure::InvalidCommand) + 1;
+
+    /**
+     * Values of all counters at one point in time.
+     */
+    struct Snapshot
+    {
+        std::array<std::int64_t, CounterCount>          m_counters{};
+        std::array<std::int64_t, DecodeFailureCount>    m_decodeFailures{};
+
+        std::int64_t get(Counter counter) const { return m_counters[static_cast<std::size_t>(counter)]; }
+        std::int64_t get(DecodeFailure reason) const { return m_decodeFailures[static_cast<std::size_t>(reason)]; }
+    };
+
+    enum class Format
+    {
+        Prometheus,
+        Json
+    };
+
+public:
+    //==============================================================================
+    /**
+     * Class constructor.
+     *
+     * @param[in] aggregate     Registry to forward everything counted to. Defaults to the process wide aggregate.
+     */
+    explicit Ocp1Metrics(Ocp1Metrics* aggregate = &GetAggregate());
+    ~Ocp1Metrics();
+
+    /**
+     * Gets the process wide aggregate of all connections' metrics.
+     */
+    static Ocp1Metrics& GetAggregate();
+
+    //==============================================================================
+    void add(Counter counter, std::int64_t delta = 1);
+    void decodeFailed(DecodeFailure reason);
+
+    std::int64_t get(Counter counter) const;
+    Snapshot getSnapshot() const;
+
+    //==============================================================================
+    /**
+     * Renders the current values in the given format.
+     *
+     * @param[in] format    Prometheus text exposition format or JSON.
+     * @param[in] label     Optional. Value of the "connection" label (Prometheus) or field (JSON), to tell instances apart.
+     */
+    juce::String toString(Format format, const juce::String& label = juce::String()) const;
+
+    /**
+     * Writes the current values to the given file, replacing its contents, e.g. for a node exporter textfile collector.
+     */
+    bool dumpToFile(const juce::File& file, Format format, const juce::String& label = juce::String()) const;
+
+    static const char* GetCounterName(Counter counter);
+    static const char* GetDecodeFailureName(DecodeFailure reason);
+
+private:
+    //==============================================================================
+    Ocp1Metrics*                                                m_aggregate{ nullptr };
+    std::array<std::atomic<std::int64_t>, CounterCount>         m_counters{};
+    std::array<std::atomic<std::int64_t>, DecodeFailureCount>   m_decodeFailures{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1Metrics)
+};
+
+}
@@ -0,0 +1,169 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1NotificationDispatcher.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1NotificationDispatcher::Ocp1NotificationDispatcher()
+{
+}
+
+Ocp1NotificationDispatcher::~Ocp1NotificationDispatcher()
+{
+}
+
+//==============================================================================
+void Ocp1NotificationDispatcher::addHandler(const Ocp1CommandDefinition& def, const NotificationHandler& handler)
+{
+    addHandler(def.GetPropertyKey(), handler);
+}
+
+void Ocp1NotificationDispatcher::addHandler(std::uint64_t propertyKey, const NotificationHandler& handler)
+{
+    auto slot = findSlot(propertyKey);
+    if (slot < m_table.size())
+    {
+        m_entries[m_table[slot]].m_handler = handler;
+        return;
+    }
+
+    m_entries.push_back({ propertyKey, handler });
+
+    // Keep the load factor at or below 0.5, so that probe sequences stay short.
+    if (m_entries.size() * 2 > m_table.size())
+        rehash(juce::jmax(MinTableSize, m_table.size() * 2));
+    else
+        insertSlot(propertyKey, static_cast<std::uint32_t>(m_entries.size() - 1));
+}
+
+bool Ocp1NotificationDispatcher::removeHandler(const Ocp1CommandDefinition& def)
+{
+    return removeHandler(def.GetPropertyKey());
+}
+
+bool Ocp1NotificationDispatcher::removeHandler(std::uint64_t propertyKey)
+{
+    auto slot = findSlot(propertyKey);
+    if (slot >= m_table.size())
+        return false;
+
+    auto entryIndex = m_table[slot];
+    eraseSlot(slot);
+
+    // Fill the gap in the entries with the last one, to keep them densely packed.
+    auto lastIndex = static_cast<std::uint32_t>(m_entries.size() - 1);
+    if (entryIndex != lastIndex)
+    {
+        m_table[findSlot(m_entries[lastIndex].m_propertyKey)] = entryIndex;
+        m_entries[entryIndex] = std::move(m_entries[lastIndex]);
+    }
+    m_entries.pop_back();
+
+    return true;
+}
+
+void Ocp1NotificationDispatcher::clear()
+{
+    m_entries.clear();
+    m_table.clear();
+}
+
+//==============================================================================
+bool Ocp1NotificationDispatcher::dispatch(const Ocp1Notification& notification) const
+{
+    auto slot = findSlot(notification.GetPropertyKey());
+    if (slot >= m_table.size())
+        return false;
+
+    // Handlers must not add or remove handlers, since that may invalidate this reference.
+    const auto& handler = m_entries[m_table[slot]].m_handler;
+    if (handler)
+        handler(notification);
+
+    return true;
+}
+
+std::size_t Ocp1NotificationDispatcher::getHandlerCount() const
+{
+    return m_entries.size();
+}
+
+//==============================================================================
+std::size_t Ocp1NotificationDispatcher::findSlot(std::uint64_t propertyKey) const
+{
+    if (m_table.empty())
+        return m_table.size();
+
+    const auto mask = m_table.size() - 1;
+    for (auto slot = HashPropertyKey(propertyKey) & mask; ; slot = (slot + 1) & mask)
+    {
+        auto entryIndex = m_table[slot];
+        if (entryIndex == EmptySlot)
+            return m_table.size();
+        if (m_entries[entryIndex].m_propertyKey == propertyKey)
+            return slot;
+    }
+}
+
+void Ocp1NotificationDispatcher::insertSlot(std::uint64_t propertyKey, std::uint32_t entryIndex)
+{
+    const auto mask = m_table.size() - 1;
+    auto slot = HashPropertyKey(propertyKey) & mask;
+    while (m_table[slot] != EmptySlot)
+        slot = (slot + 1) & mask;
+
+    m_table[slot] = entryIndex;
+}
+
+void Ocp1NotificationDispatcher::eraseSlot(std::size_t slot)
+{
+    // Backward shift deletion: move following entries of the probe sequence into the gap,
+    // unless their home slot lies (cyclically) between the gap and their current slot.
+    const auto mask = m_table.size() - 1;
+    auto gap = slot;
+    for (auto next = (gap + 1) & mask; m_table[next] != EmptySlot; next = (next + 1) & mask)
+    {
+        auto home = HashPropertyKey(m_entries[m_table[next]].m_propertyKey) & mask;
+        auto homeBetween = (gap <= next) ? (gap < home && home <= next) : (gap < home || home <= next);
+        if (homeBetween)
+            continue;
+
+        m_table[gap] = m_table[next];
+        gap = next;
+    }
+
+    m_table[gap] = EmptySlot;
+}
+
+void Ocp1NotificationDispatcher::rehash(std::size_t tableSize)
+{
+    jassert(juce::isPowerOfTwo(tableSize));
+
+    m_table.assign(tableSize, EmptySlot);
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+        insertSlot(m_entries[i].m_propertyKey, static_cast<std::uint32_t>(i));
+}
+
+
+}
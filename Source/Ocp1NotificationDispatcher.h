@@ -0,0 +1,116 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+
+namespace NanoOcp1
+{
+
+struct Ocp1CommandDefinition;
+class Ocp1Notification;
+
+
+//==============================================================================
+/**
+    Routes received notifications to handlers registered per property.
+
+    Each handler is registered for the property key (see GetPropertyKey) of an object
+    definition. The keys are kept in a flat, open addressing hash table, so the cost of
+    dispatching a notification does not depend on the number of registered properties,
+    unlike matching it against every known definition with Ocp1Notification::MatchesObject.
+
+    The dispatcher is not synchronized. Handlers must be registered and notifications
+    dispatched on the same thread, usually the one the received data is delivered on.
+*/
+class Ocp1NotificationDispatcher
+{
+public:
+    using NotificationHandler = std::function<void(const Ocp1Notification& notification)>;
+
+public:
+    //==============================================================================
+    Ocp1NotificationDispatcher();
+    ~Ocp1NotificationDispatcher();
+
+    //==============================================================================
+    /**
+     * Registers the handler for notifications of the property addressed by the given definition.
+     * A handler already registered for the same property is replaced.
+     *
+     * @param[in] def       Object definition of the property.
+     * @param[in] handler   Handler to invoke for every notification of the property.
+     */
+    void addHandler(const Ocp1CommandDefinition& def, const NotificationHandler& handler);
+    void addHandler(std::uint64_t propertyKey, const NotificationHandler& handler);
+
+    /**
+     * Unregisters the handler for the property addressed by the given definition.
+     *
+     * @return  True if a handler was registered for the property.
+     */
+    bool removeHandler(const Ocp1CommandDefinition& def);
+    bool removeHandler(std::uint64_t propertyKey);
+
+    /**
+     * Unregisters all handlers.
+     */
+    void clear();
+
+    //==============================================================================
+    /**
+     * Invokes the handler registered for the property whose change triggered the given notification.
+     *
+     * @param[in] notification  The received notification.
+     * @return  True if a handler was registered for the notification's property.
+     */
+    bool dispatch(const Ocp1Notification& notification) const;
+
+    std::size_t getHandlerCount() const;
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        std::uint64_t       m_propertyKey;
+        NotificationHandler m_handler;
+    };
+
+    static constexpr std::uint32_t EmptySlot = 0xFFFFFFFF;
+    static constexpr std::size_t MinTableSize = 16;
+
+    //==============================================================================
+    std::size_t findSlot(std::uint64_t propertyKey) const;
+    void insertSlot(std::uint64_t propertyKey, std::uint32_t entryIndex);
+    void eraseSlot(std::size_t slot);
+    void rehash(std::size_t tableSize);
+
+    //==============================================================================
+    std::vector<Entry>          m_entries;  // Densely packed registered handlers.
+    std::vector<std::uint32_t>  m_table;    // Indices into m_entries, power of two sized, linear probing.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1NotificationDispatcher)
+};
+
+}
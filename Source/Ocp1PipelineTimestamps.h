@@ -0,0 +1,134 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1LatencyHistogram.h"
+
+
+/**
+ * Set to 1 in the project's preprocessor definitions to timestamp every received message
+ * along its way through Ocp1Connection. With the default of 0, none of it is compiled in.
+ */
+#ifndef NANOOCP1_PIPELINE_TIMESTAMPS
+    #define NANOOCP1_PIPELINE_TIMESTAMPS 0
+#endif
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Monotonic timestamps (juce::Time::getHighResolutionTicks) taken for a single
+    received message at the stages of the receive pipeline.
+*/
+struct Ocp1PipelineTimestamps
+{
+    enum Stage
+    {
+        SocketReadable = 0, // Socket reported data to be available.
+        PduComplete,        // Complete message read from the socket.
+        Preprocessed,       // Ocp1Connection::preprocessMessage returned on the reader thread. Messages are not decoded yet.
+        Enqueued,           // Posted for delivery on the message thread, or about to be delivered directly.
+        CallbackEntered,    // Ocp1Connection::messageReceived entered.
+        StageCount
+    };
+
+    void stamp(Stage stage)
+    {
+        m_ticks[stage] = juce::Time::getHighResolutionTicks();
+    }
+
+    /**
+     * Time between two stages in microseconds, or 0 if either was not stamped.
+     */
+    std::uint64_t getMicrosecondsBetween(Stage from, Stage to) const
+    {
+        if (m_ticks[from] == 0 || m_ticks[to] < m_ticks[from])
+            return 0;
+
+        return static_cast<std::uint64_t>(juce::Time::highResolutionTicksToSeconds(m_ticks[to] - m_ticks[from]) * 1000000.0);
+    }
+
+    std::array<std::int64_t, StageCount> m_ticks{};
+};
+
+
+//==============================================================================
+/**
+    Histograms of the time received messages spend in each part of the receive pipeline.
+*/
+class Ocp1PipelineStats
+{
+public:
+    /**
+     * Part of the pipeline, each one spanning from one stage to the next.
+     */
+    enum Interval
+    {
+        Read = 0,       // SocketReadable to PduComplete.
+        Preprocess,     // PduComplete to Preprocessed, e.g. property mirror and meter aggregation.
+        Enqueue,        // Preprocessed to Enqueued.
+        Delivery,       // Enqueued to CallbackEntered, i.e. waiting in the message queue.
+        Total,          // SocketReadable to CallbackEntered.
+        IntervalCount
+    };
+
+public:
+    //==============================================================================
+    Ocp1PipelineStats() = default;
+    ~Ocp1PipelineStats() = default;
+
+    //==============================================================================
+    void record(const Ocp1PipelineTimestamps& timestamps)
+    {
+        using Stage = Ocp1PipelineTimestamps;
+        m_histograms[Read].record(timestamps.getMicrosecondsBetween(Stage::SocketReadable, Stage::PduComplete));
+        m_histograms[Preprocess].record(timestamps.getMicrosecondsBetween(Stage::PduComplete, Stage::Preprocessed));
+        m_histograms[Enqueue].record(timestamps.getMicrosecondsBetween(Stage::Preprocessed, Stage::Enqueued));
+        m_histograms[Delivery].record(timestamps.getMicrosecondsBetween(Stage::Enqueued, Stage::CallbackEntered));
+        m_histograms[Total].record(timestamps.getMicrosecondsBetween(Stage::SocketReadable, Stage::CallbackEntered));
+    }
+
+    const Ocp1LatencyHistogram& getHistogram(Interval interval) const
+    {
+        return m_histograms[interval];
+    }
+
+    void reset()
+    {
+        for (auto& histogram : m_histograms)
+            histogram.reset();
+    }
+
+private:
+    //==============================================================================
+    std::array<Ocp1LatencyHistogram, IntervalCount> m_histograms;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1PipelineStats)
+};
+
+}
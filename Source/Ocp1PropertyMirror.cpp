@@ -0,0 +1,299 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1PropertyMirror.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1PropertyMirror::Ocp1PropertyMirror(std::size_t capacity, std::size_t changeLogSize)
+    : m_capacity(capacity)
+{
+    m_changeLog.resize(juce::jmax(std::size_t(1), changeLogSize), { 0, 0 });
+
+    // The index is kept at a load factor of at most 0.5.
+    auto indexSize = static_cast<std::size_t>(juce::nextPowerOfTwo(static_cast<int>(juce::jmax(std::size_t(8), capacity * 2))));
+    m_indexMask = indexSize - 1;
+
+    m_entries = std::make_unique<Entry[]>(m_capacity);
+    m_index = std::make_unique<std::atomic<std::uint32_t>[]>(indexSize);
+    for (std::size_t i = 0; i < indexSize; i++)
+        m_index[i].store(EmptySlot, std::memory_order_relaxed);
+}
+
+Ocp1PropertyMirror::~Ocp1PropertyMirror()
+{
+}
+
+//==============================================================================
+bool Ocp1PropertyMirror::addProperty(const Ocp1CommandDefinition& def)
+{
+    const juce::ScopedLock sl(m_writeLock);
+
+    auto propertyKey = def.GetPropertyKey();
+    if (findEntry(propertyKey) != nullptr)
+        return true;
+
+    auto entryIndex = m_entryCount.load(std::memory_order_relaxed);
+    if (entryIndex >= m_capacity)
+    {
+        jassertfalse; // Mirror capacity exhausted.
+        return false;
+    }
+
+    auto& entry = m_entries[entryIndex];
+    entry.m_propertyKey = propertyKey;
+    entry.m_def.reset(def.Clone());
+
+    auto slot = HashPropertyKey(propertyKey) & m_indexMask;
+    while (m_index[slot].load(std::memory_order_relaxed) != EmptySlot)
+        slot = (slot + 1) & m_indexMask;
+
+    // Publish the fully initialized entry to readers.
+    m_index[slot].store(static_cast<std::uint32_t>(entryIndex), std::memory_order_release);
+    m_entryCount.store(entryIndex + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool Ocp1PropertyMirror::containsProperty(std::uint64_t propertyKey) const
+{
+    return findEntry(propertyKey) != nullptr;
+}
+
+std::size_t Ocp1PropertyMirror::getPropertyCount() const
+{
+    return m_entryCount.load(std::memory_order_acquire);
+}
+
+std::size_t Ocp1PropertyMirror::getCapacity() const
+{
+    return m_capacity;
+}
+
+const Ocp1CommandDefinition* Ocp1PropertyMirror::getPropertyDefinition(std::uint64_t propertyKey) const
+{
+    const auto* entry = findEntry(propertyKey);
+    return entry != nullptr ? entry->m_def.get() : nullptr;
+}
+
+std::vector<const Ocp1CommandDefinition*> Ocp1PropertyMirror::getPropertyDefinitions() const
+{
+    auto entryCount = m_entryCount.load(std::memory_order_acquire);
+
+    std::vector<const Ocp1CommandDefinition*> defs;
+    defs.reserve(entryCount);
+    for (std::size_t i = 0; i < entryCount; i++)
+        defs.push_back(m_entries[i].m_def.get());
+
+    return defs;
+}
+
+//==============================================================================
+bool Ocp1PropertyMirror::update(std::uint64_t propertyKey, const std::vector<std::uint8_t>& data)
+{
+    return update(propertyKey, data.data(), data.size());
+}
+
+bool Ocp1PropertyMirror::update(std::uint64_t propertyKey, const std::uint8_t* data, std::size_t size)
+{
+    if (size > MaxValueSize)
+        return false;
+
+    // Entries are never removed, so the entry can be looked up before taking the lock.
+    auto* entry = const_cast<Entry*>(findEntry(propertyKey));
+    if (entry == nullptr)
+        return false;
+
+    std::array<std::uint64_t, ValueWordCount> words{};
+    if (size > 0)
+        std::memcpy(words.data(), data, size);
+    const auto wordCount = (size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    const juce::ScopedLock sl(m_writeLock);
+
+    auto version = m_version.load(std::memory_order_relaxed) + 1;
+
+    auto sequence = entry->m_sequence.load(std::memory_order_relaxed);
+    entry->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < wordCount; i++)
+        entry->m_value[i].store(words[i], std::memory_order_relaxed);
+    entry->m_size.store(static_cast<std::uint32_t>(size), std::memory_order_relaxed);
+    entry->m_hasValue.store(true, std::memory_order_relaxed);
+    entry->m_version.store(version, std::memory_order_relaxed);
+
+    entry->m_sequence.store(sequence + 2, std::memory_order_release);
+
+    m_changeLog[m_changeLogHead] = { version, static_cast<std::uint32_t>(entry - m_entries.get()) };
+    m_changeLogHead = (m_changeLogHead + 1) % m_changeLog.size();
+    m_version.store(version, std::memory_order_release);
+
+    return true;
+}
+
+bool Ocp1PropertyMirror::processReceivedData(const ByteVector& data)
+{
+    // All notifications of a PDU are mirrored, the device may batch them.
+    auto updated = false;
+    Ocp1Notification::VisitPropertyChanges(data, [this, &updated](std::uint64_t propertyKey, std::span<const std::uint8_t> value) {
+        updated |= update(propertyKey, value.data(), value.size());
+    });
+
+    return updated;
+}
+
+//==============================================================================
+Variant Ocp1PropertyMirror::getValue(std::uint64_t propertyKey, bool* pOk) const
+{
+    if (pOk != nullptr)
+        *pOk = false;
+
+    const auto* entry = findEntry(propertyKey);
+    if (entry == nullptr)
+        return {};
+
+    std::array<std::uint64_t, ValueWordCount> words;
+    std::uint32_t size = 0;
+    if (!readEntry(*entry, words, size))
+        return {};
+
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(words.data());
+    if (pOk != nullptr)
+        *pOk = true;
+
+    return Variant(std::span<const std::uint8_t>(bytes, size), entry->m_def->GetDataType());
+}
+
+Variant Ocp1PropertyMirror::getValue(const Ocp1CommandDefinition& def, bool* pOk) const
+{
+    return getValue(def.GetPropertyKey(), pOk);
+}
+
+bool Ocp1PropertyMirror::getRawValue(std::uint64_t propertyKey, std::vector<std::uint8_t>& data) const
+{
+    const auto* entry = findEntry(propertyKey);
+    if (entry == nullptr)
+        return false;
+
+    std::array<std::uint64_t, ValueWordCount> words;
+    std::uint32_t size = 0;
+    if (!readEntry(*entry, words, size))
+        return false;
+
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(words.data());
+    data.assign(bytes, bytes + size);
+
+    return true;
+}
+
+//==============================================================================
+std::uint64_t Ocp1PropertyMirror::getVersion() const
+{
+    return m_version.load(std::memory_order_acquire);
+}
+
+std::uint64_t Ocp1PropertyMirror::changesSince(std::uint64_t version, std::vector<std::uint64_t>& changedKeys) const
+{
+    changedKeys.clear();
+
+    // Holding the write lock keeps the change log and the entry versions consistent.
+    const juce::ScopedLock sl(m_writeLock);
+
+    const auto currentVersion = m_version.load(std::memory_order_relaxed);
+    if (version >= currentVersion)
+        return currentVersion;
+
+    // Every update is logged, so the log holds the changes of the last m_changeLog.size() versions.
+    const auto changeCount = currentVersion - version;
+    if (changeCount <= m_changeLog.size())
+    {
+        auto position = (m_changeLogHead + m_changeLog.size() - static_cast<std::size_t>(changeCount)) % m_changeLog.size();
+        for (std::uint64_t i = 0; i < changeCount; i++)
+        {
+            const auto& change = m_changeLog[position];
+            const auto& entry = m_entries[change.m_entryIndex];
+
+            // Skip changes superseded by a later update of the same property.
+            if (entry.m_version.load(std::memory_order_relaxed) == change.m_version)
+                changedKeys.push_back(entry.m_propertyKey);
+
+            position = (position + 1) % m_changeLog.size();
+        }
+    }
+    else
+    {
+        // Fell behind further than the log reaches.
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> changedEntries;
+        const auto entryCount = m_entryCount.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < entryCount; i++)
+        {
+            const auto entryVersion = m_entries[i].m_version.load(std::memory_order_relaxed);
+            if (entryVersion > version)
+                changedEntries.emplace_back(entryVersion, m_entries[i].m_propertyKey);
+        }
+
+        std::sort(changedEntries.begin(), changedEntries.end());
+        changedKeys.reserve(changedEntries.size());
+        for (const auto& changedEntry : changedEntries)
+            changedKeys.push_back(changedEntry.second);
+    }
+
+    return currentVersion;
+}
+
+//==============================================================================
+const Ocp1PropertyMirror::Entry* Ocp1PropertyMirror::findEntry(std::uint64_t propertyKey) const
+{
+    for (auto slot = HashPropertyKey(propertyKey) & m_indexMask; ; slot = (slot + 1) & m_indexMask)
+    {
+        auto entryIndex = m_index[slot].load(std::memory_order_acquire);
+        if (entryIndex == EmptySlot)
+            return nullptr;
+        if (m_entries[entryIndex].m_propertyKey == propertyKey)
+            return &m_entries[entryIndex];
+    }
+}
+
+bool Ocp1PropertyMirror::readEntry(const Entry& entry, std::array<std::uint64_t, ValueWordCount>& value, std::uint32_t& size) const
+{
+    for (;;)
+    {
+        auto sequenceBefore = entry.m_sequence.load(std::memory_order_acquire);
+        if ((sequenceBefore & 1) != 0)
+            continue; // Update in progress.
+
+        auto hasValue = entry.m_hasValue.load(std::memory_order_relaxed);
+        size = entry.m_size.load(std::memory_order_relaxed);
+        const auto wordCount = (juce::jmin(static_cast<std::size_t>(size), MaxValueSize) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < wordCount; i++)
+            value[i] = entry.m_value[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.m_sequence.load(std::memory_order_relaxed) == sequenceBefore)
+            return hasValue;
+    }
+}
+
+
+}
@@ -0,0 +1,200 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+#include "Variant.h"
+
+
+namespace NanoOcp1
+{
+
+struct Ocp1CommandDefinition;
+
+
+//==============================================================================
+/**
+    Local mirror of the last known values of device properties.
+
+    Properties are registered once per object definition and are identified by their
+    property key (see GetPropertyKey). The mirror is updated by the thread that delivers
+    received data, from notifications and Get responses, and can be read from any number
+    of threads at the same time without taking a lock: every entry is guarded by a
+    sequence lock, readers simply retry if they raced with an update of the same entry.
+
+    To make that possible, the registered entries are never moved or removed, and values
+    are kept in their marshaled form in a fixed size buffer per entry. Values larger
+    than MaxValueSize (i.e. long strings or blobs) are not mirrored.
+
+    Every update bumps the mirror version and stamps the entry with it. Consumers that
+    sync incrementally call changesSince with the version returned by their last call.
+    Recent changes are kept in a change log, so such a query only costs as much as the
+    number of changes. Only if the consumer fell behind further than the log reaches,
+    all entries are scanned for their version stamp instead.
+*/
+class Ocp1PropertyMirror
+{
+public:
+    /**
+     * Maximum size of a marshaled property value that can be mirrored, in bytes.
+     */
+    static constexpr std::size_t MaxValueSize = 128;
+
+    static constexpr std::size_t DefaultCapacity = 16384;
+    static constexpr std::size_t DefaultChangeLogSize = 65536;
+
+public:
+    //==============================================================================
+    Ocp1PropertyMirror(std::size_t capacity = DefaultCapacity, std::size_t changeLogSize = DefaultChangeLogSize);
+    ~Ocp1PropertyMirror();
+
+    //==============================================================================
+    /**
+     * Registers the property addressed by the given definition, so that its value is mirrored.
+     * Registering a property that is already registered has no effect.
+     *
+     * @param[in] def   Object definition of the property. Its data type is used to interpret the value.
+     * @return  True if the property is registered, false if the capacity is exhausted.
+     */
+    bool addProperty(const Ocp1CommandDefinition& def);
+
+    bool containsProperty(std::uint64_t propertyKey) const;
+    std::size_t getPropertyCount() const;
+    std::size_t getCapacity() const;
+
+    /**
+     * Gets the definition a property was registered with.
+     *
+     * @param[in] propertyKey   Key of the property, see GetPropertyKey.
+     * @return  The definition, valid for the lifetime of the mirror, or nullptr if the property is not registered.
+     */
+    const Ocp1CommandDefinition* getPropertyDefinition(std::uint64_t propertyKey) const;
+
+    /**
+     * Gets the definitions of all registered properties, in the order they were registered.
+     * The pointers stay valid for the lifetime of the mirror.
+     */
+    std::vector<const Ocp1CommandDefinition*> getPropertyDefinitions() const;
+
+    //==============================================================================
+    /**
+     * Stores the given marshaled value for a registered property.
+     *
+     * @param[in] propertyKey   Key of the property, see GetPropertyKey.
+     * @param[in] data          Marshaled property value, as contained in a notification or Get response.
+     * @return  True if the property is registered and the value fits into the mirror.
+     */
+    bool update(std::uint64_t propertyKey, const std::vector<std::uint8_t>& data);
+    bool update(std::uint64_t propertyKey, const std::uint8_t* data, std::size_t size);
+
+    /**
+     * Updates the mirror with every PropertyChanged notification of the given serialized message
+     * that concerns a registered property. The message is not unmarshaled, the property keys and
+     * values are read from the raw data.
+     *
+     * @param[in] data  Serialized OCA message as received.
+     * @return  True if the mirror was updated with at least one value.
+     */
+    bool processReceivedData(const ByteVector& data);
+
+    //==============================================================================
+    /**
+     * Gets the last known value of a property, without taking a lock.
+     *
+     * @param[in] propertyKey   Key of the property, see GetPropertyKey.
+     * @param[out] pOk          Optional. Set to true if the property is registered and has a value.
+     * @return  The value, interpreted according to the data type of the registered definition.
+     */
+    Variant getValue(std::uint64_t propertyKey, bool* pOk = nullptr) const;
+    Variant getValue(const Ocp1CommandDefinition& def, bool* pOk = nullptr) const;
+
+    /**
+     * Same as getValue, but returns the marshaled value.
+     */
+    bool getRawValue(std::uint64_t propertyKey, std::vector<std::uint8_t>& data) const;
+
+    //==============================================================================
+    /**
+     * Gets the current version of the mirror, which is incremented with every update.
+     * Version 0 means the mirror was never updated.
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * Gets the keys of all properties that were updated after the given version.
+     * Each property is contained only once, no matter how often it was updated.
+     *
+     * @param[in] version       Version returned by the previous call, or 0 to get all properties with a value.
+     * @param[out] changedKeys  Keys of the updated properties, in the order of their latest update.
+     * @return  The current version, to be passed to the next call.
+     */
+    std::uint64_t changesSince(std::uint64_t version, std::vector<std::uint64_t>& changedKeys) const;
+
+private:
+    //==============================================================================
+    static constexpr std::size_t ValueWordCount = MaxValueSize / sizeof(std::uint64_t);
+    static constexpr std::uint32_t EmptySlot = 0xFFFFFFFF;
+
+    struct Entry
+    {
+        // Immutable once the entry is published in the index.
+        std::uint64_t                                   m_propertyKey{ 0 };
+        std::unique_ptr<Ocp1CommandDefinition>          m_def;
+
+        // Guarded by the sequence lock. Odd sequence numbers mean an update is in progress.
+        std::atomic<std::uint32_t>                      m_sequence{ 0 };
+        std::atomic<std::uint32_t>                      m_size{ 0 };
+        std::atomic<bool>                               m_hasValue{ false };
+        std::atomic<std::uint64_t>                      m_version{ 0 };     // Mirror version of the last update.
+        std::array<std::atomic<std::uint64_t>, ValueWordCount> m_value{};
+    };
+
+    //==============================================================================
+    const Entry* findEntry(std::uint64_t propertyKey) const;
+    bool readEntry(const Entry& entry, std::array<std::uint64_t, ValueWordCount>& value, std::uint32_t& size) const;
+
+    //==============================================================================
+    std::size_t                                 m_capacity{ 0 };
+    std::unique_ptr<Entry[]>                    m_entries;          // Never reallocated, readers hold no lock.
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_index;          // Open addressing, linear probing, indices into m_entries.
+    std::size_t                                 m_indexMask{ 0 };
+    std::atomic<std::size_t>                    m_entryCount{ 0 };
+
+    struct Change
+    {
+        std::uint64_t   m_version;
+        std::uint32_t   m_entryIndex;
+    };
+
+    std::atomic<std::uint64_t>                  m_version{ 0 };
+    std::vector<Change>                         m_changeLog;        // Ring buffer, guarded by m_writeLock.
+    std::size_t                                 m_changeLogHead{ 0 };   // Position of the next change to log.
+
+    juce::CriticalSection                       m_writeLock;        // Serializes writers, value readers never take it.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1PropertyMirror)
+};
+
+}
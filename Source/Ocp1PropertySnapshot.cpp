@@ -0,0 +1,256 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1PropertySnapshot.h"
+#include "Ocp1Message.h"
+#include "Ocp1PropertyMirror.h"
+
+
+namespace NanoOcp1
+{
+
+
+static constexpr std::uint8_t SnapshotMagic[] = { 'N', 'O', 'C', 'S' };
+
+
+//==============================================================================
+Ocp1PropertySnapshot::Ocp1PropertySnapshot()
+{
+}
+
+Ocp1PropertySnapshot::~Ocp1PropertySnapshot()
+{
+}
+
+//==============================================================================
+bool Ocp1PropertySnapshot::Write(const juce::File& file, const Ocp1PropertyMirror& mirror, const std::string& deviceGuid)
+{
+    struct SnapshotValue
+    {
+        std::uint64_t               m_propertyKey;
+        std::uint16_t               m_dataType;
+        std::vector<std::uint8_t>   m_data;
+    };
+
+    std::vector<SnapshotValue> values;
+    for (const auto* def : mirror.getPropertyDefinitions())
+    {
+        SnapshotValue value{ def->GetPropertyKey(), def->m_propertyType, {} };
+        if (mirror.getRawValue(value.m_propertyKey, value.m_data))
+            values.push_back(std::move(value));
+    }
+
+    // Sorted records allow binary search in the snapshot.
+    std::sort(values.begin(), values.end(), [](const auto& a, const auto& b) { return a.m_propertyKey < b.m_propertyKey; });
+
+    if (deviceGuid.size() > 0xFFFF)
+        return false;
+
+    std::vector<std::uint8_t> snapshot;
+    auto append = [&snapshot](const std::vector<std::uint8_t>& data) { snapshot.insert(snapshot.end(), data.begin(), data.end()); };
+
+    snapshot.insert(snapshot.end(), std::begin(SnapshotMagic), std::end(SnapshotMagic));
+    append(DataFromUint16(FormatVersion));
+    append(DataFromUint16(0));
+    append(DataFromUint32(static_cast<std::uint32_t>(values.size())));
+    append(DataFromUint16(static_cast<std::uint16_t>(deviceGuid.size())));
+    snapshot.insert(snapshot.end(), deviceGuid.begin(), deviceGuid.end());
+
+    std::uint32_t valueOffset = 0;
+    for (const auto& value : values)
+    {
+        append(DataFromUint64(value.m_propertyKey));
+        append(DataFromUint16(value.m_dataType));
+        append(DataFromUint16(static_cast<std::uint16_t>(value.m_data.size())));
+        append(DataFromUint32(valueOffset));
+        valueOffset += static_cast<std::uint32_t>(value.m_data.size());
+    }
+
+    for (const auto& value : values)
+        append(value.m_data);
+
+    return file.replaceWithData(snapshot.data(), snapshot.size());
+}
+
+//==============================================================================
+bool Ocp1PropertySnapshot::open(const juce::File& file)
+{
+    close();
+
+    juce::FileInputStream stream(file);
+    const auto fileSize = stream.openedOk() ? stream.getTotalLength() : 0;
+    if (fileSize < static_cast<std::int64_t>(FixedHeaderSize) || fileSize > std::numeric_limits<int>::max())
+        return false;
+
+    m_data.resize(static_cast<std::size_t>(fileSize));
+    if (stream.read(m_data.data(), static_cast<int>(fileSize)) != static_cast<int>(fileSize))
+    {
+        close();
+        return false;
+    }
+
+    const auto* data = m_data.data();
+    const auto size = m_data.size();
+    if (std::memcmp(data, SnapshotMagic, sizeof(SnapshotMagic)) != 0
+        || ReadUint16(data + 4) != FormatVersion)
+    {
+        close();
+        return false;
+    }
+
+    const std::size_t recordCount = ReadUint32(data + 8);
+    const std::size_t deviceGuidSize = ReadUint16(data + 12);
+    const auto recordsOffset = FixedHeaderSize + deviceGuidSize;
+    const auto valuesOffset = recordsOffset + recordCount * RecordSize;
+    if (valuesOffset > size)
+    {
+        close();
+        return false;
+    }
+
+    m_deviceGuid.assign(reinterpret_cast<const char*>(data + FixedHeaderSize), deviceGuidSize);
+    m_recordCount = recordCount;
+    m_records = data + recordsOffset;
+    m_values = data + valuesOffset;
+    m_valuesSize = size - valuesOffset;
+
+    // Validate all records once, so that lookups need no further checks.
+    for (std::size_t i = 0; i < m_recordCount; i++)
+    {
+        const auto* record = getRecord(i);
+        const std::size_t valueSize = ReadUint16(record + 10);
+        const std::size_t valueOffset = ReadUint32(record + 12);
+        const auto isSorted = (i == 0 || GetRecordKey(getRecord(i - 1)) < GetRecordKey(record));
+        if (!isSorted || valueOffset + valueSize > m_valuesSize)
+        {
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Ocp1PropertySnapshot::close()
+{
+    m_data = ByteVector();
+    m_deviceGuid.clear();
+    m_recordCount = 0;
+    m_records = nullptr;
+    m_values = nullptr;
+    m_valuesSize = 0;
+}
+
+bool Ocp1PropertySnapshot::isOpen() const
+{
+    return m_records != nullptr;
+}
+
+const std::string& Ocp1PropertySnapshot::getDeviceGuid() const
+{
+    return m_deviceGuid;
+}
+
+std::size_t Ocp1PropertySnapshot::getRecordCount() const
+{
+    return m_recordCount;
+}
+
+//==============================================================================
+std::span<const std::uint8_t> Ocp1PropertySnapshot::getRawValue(std::uint64_t propertyKey, bool* pOk) const
+{
+    const auto* record = findRecord(propertyKey);
+    if (pOk != nullptr)
+        *pOk = (record != nullptr);
+
+    if (record == nullptr)
+        return {};
+
+    return getRecordValue(record);
+}
+
+Variant Ocp1PropertySnapshot::getValue(std::uint64_t propertyKey, bool* pOk) const
+{
+    const auto* record = findRecord(propertyKey);
+    if (pOk != nullptr)
+        *pOk = (record != nullptr);
+
+    if (record == nullptr)
+        return {};
+
+    const auto value = getRecordValue(record);
+    return Variant(value, static_cast<Ocp1DataType>(ReadUint16(record + 8)));
+}
+
+std::size_t Ocp1PropertySnapshot::applyTo(Ocp1PropertyMirror& mirror) const
+{
+    std::size_t updatedCount = 0;
+    for (std::size_t i = 0; i < m_recordCount; i++)
+    {
+        const auto* record = getRecord(i);
+        const auto propertyKey = GetRecordKey(record);
+
+        const auto* def = mirror.getPropertyDefinition(propertyKey);
+        if (def == nullptr || def->GetDataType() != static_cast<Ocp1DataType>(ReadUint16(record + 8)))
+            continue;
+
+        const auto value = getRecordValue(record);
+        if (mirror.update(propertyKey, value.data(), value.size()))
+            updatedCount++;
+    }
+
+    return updatedCount;
+}
+
+//==============================================================================
+const std::uint8_t* Ocp1PropertySnapshot::getRecord(std::size_t recordIndex) const
+{
+    return m_records + recordIndex * RecordSize;
+}
+
+std::uint64_t Ocp1PropertySnapshot::GetRecordKey(const std::uint8_t* record)
+{
+    return (static_cast<std::uint64_t>(ReadUint32(record)) << 32) | ReadUint32(record + 4);
+}
+
+std::span<const std::uint8_t> Ocp1PropertySnapshot::getRecordValue(const std::uint8_t* record) const
+{
+    return { m_values + ReadUint32(record + 12), ReadUint16(record + 10) };
+}
+
+const std::uint8_t* Ocp1PropertySnapshot::findRecord(std::uint64_t propertyKey) const
+{
+    std::size_t first = 0;
+    std::size_t last = m_recordCount;
+    while (first < last)
+    {
+        auto middle = first + (last - first) / 2;
+        auto middleKey = GetRecordKey(getRecord(middle));
+        if (middleKey == propertyKey)
+            return getRecord(middle);
+        else if (middleKey < propertyKey)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return nullptr;
+}
+
+
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include <span>
+
+#include "Ocp1DataTypes.h"
+#include "Variant.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1PropertyMirror;
+
+
+//==============================================================================
+/**
+    Compact binary snapshot of the values held by a Ocp1PropertyMirror, used to warm start
+    an application before the device was read.
+
+    Snapshot files are read into memory when opened and validated once, values are then read
+    straight from that buffer. All numbers are stored big endian, like on the wire:
+
+    Header:     magic "NOCS", format version (u16), reserved (u16), record count (u32),
+                device GUID length (u16) followed by the device GUID (UTF-8).
+    Records:    one per property, sorted by property key: ONo (u32), property definition
+                level (u16), property index (u16), data type (u16), value size (u16) and
+                value offset (u32) relative to the start of the value area.
+    Values:     marshaled property values, as contained in notifications and Get responses.
+*/
+class Ocp1PropertySnapshot
+{
+public:
+    static constexpr std::uint16_t FormatVersion = 1;
+
+public:
+    //==============================================================================
+    Ocp1PropertySnapshot();
+    ~Ocp1PropertySnapshot();
+
+    //==============================================================================
+    /**
+     * Writes all properties of the given mirror that have a value into a snapshot file.
+     *
+     * @param[in] file          File to write. An existing file is replaced.
+     * @param[in] mirror        Mirror holding the values.
+     * @param[in] deviceGuid    GUID of the device the values belong to (see dbOcaObjectDef_Fixed_GUID).
+     * @return  True on success.
+     */
+    static bool Write(const juce::File& file, const Ocp1PropertyMirror& mirror, const std::string& deviceGuid);
+
+    //==============================================================================
+    /**
+     * Reads the given snapshot file and validates its contents.
+     *
+     * @param[in] file  Snapshot file as written by Write.
+     * @return  True if the file could be read and is a valid snapshot.
+     */
+    bool open(const juce::File& file);
+    void close();
+    bool isOpen() const;
+
+    const std::string& getDeviceGuid() const;
+    std::size_t getRecordCount() const;
+
+    //==============================================================================
+    /**
+     * Gets the marshaled value of a property, pointing into the snapshot's buffer.
+     * The data stays valid until the snapshot is closed.
+     *
+     * @param[in] propertyKey   Key of the property, see GetPropertyKey.
+     * @param[out] pOk          Optional. Set to true if the snapshot contains the property.
+     * @return  The marshaled value.
+     */
+    std::span<const std::uint8_t> getRawValue(std::uint64_t propertyKey, bool* pOk = nullptr) const;
+
+    /**
+     * Gets the value of a property, interpreted according to the data type it was stored with.
+     */
+    Variant getValue(std::uint64_t propertyKey, bool* pOk = nullptr) const;
+
+    /**
+     * Stores the values of all properties contained in the snapshot and registered in the given mirror into the mirror.
+     * Records whose data type differs from the one the property is registered with, e.g. in a
+     * snapshot of another firmware version or device model, are skipped.
+     *
+     * @return  Number of properties updated.
+     */
+    std::size_t applyTo(Ocp1PropertyMirror& mirror) const;
+
+private:
+    //==============================================================================
+    static constexpr std::size_t FixedHeaderSize = 14;  // Up to and including the device GUID length.
+    static constexpr std::size_t RecordSize = 16;
+
+    //==============================================================================
+    const std::uint8_t* getRecord(std::size_t recordIndex) const;
+    static std::uint64_t GetRecordKey(const std::uint8_t* record);
+    std::span<const std::uint8_t> getRecordValue(const std::uint8_t* record) const;
+    const std::uint8_t* findRecord(std::uint64_t propertyKey) const;
+
+    //==============================================================================
+    ByteVector                                  m_data;
+    std::string                                 m_deviceGuid;
+    std::size_t                                 m_recordCount{ 0 };
+    const std::uint8_t*                         m_records{ nullptr };
+    const std::uint8_t*                         m_values{ nullptr };
+    std::size_t                                 m_valuesSize{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1PropertySnapshot)
+};
+
+}
@@ -0,0 +1,251 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1RateLimiter.h"
+#include "Ocp1Message.h"
+#include "Ocp1Metrics.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1RateLimiter::Ocp1RateLimiter(const std::function<bool(const ByteVector&)>& sendFunction, Ocp1Metrics* metrics)
+    : m_sendFunction(sendFunction), m_metrics(metrics)
+{
+}
+
+Ocp1RateLimiter::~Ocp1RateLimiter()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void Ocp1RateLimiter::setBudget(TrafficClass trafficClass, double commandsPerSecond, int burstSize)
+{
+    if (trafficClass == TrafficClass::Unlimited)
+        return;
+
+    {
+        const juce::ScopedLock sl(m_bucketLock);
+
+        auto& bucket = m_buckets[static_cast<std::size_t>(trafficClass)];
+        bucket.m_commandsPerSecond = juce::jmax(0.0, commandsPerSecond);
+        bucket.m_burstSize = static_cast<double>(juce::jmax(1, burstSize));
+        bucket.m_tokens = bucket.m_burstSize;
+        bucket.m_lastRefillMs = juce::Time::getMillisecondCounterHiRes();
+    }
+
+    // Commands queued under the previous budget may be sendable now.
+    sendQueued();
+}
+
+double Ocp1RateLimiter::getCommandsPerSecond(TrafficClass trafficClass) const
+{
+    if (trafficClass == TrafficClass::Unlimited)
+        return 0.0;
+
+    const juce::ScopedLock sl(m_bucketLock);
+    return m_buckets[static_cast<std::size_t>(trafficClass)].m_commandsPerSecond;
+}
+
+//==============================================================================
+bool Ocp1RateLimiter::send(const ByteVector& data)
+{
+    auto trafficClass = GetTrafficClass(data);
+    if (trafficClass == TrafficClass::Unlimited)
+        return m_sendFunction && m_sendFunction(data);
+
+    auto sendNow = false;
+    {
+        const juce::ScopedLock sl(m_bucketLock);
+
+        auto& bucket = m_buckets[static_cast<std::size_t>(trafficClass)];
+
+        // Only bypass the queue if nothing of the same class is waiting, to keep the order.
+        if (bucket.m_queue.empty() && bucket.m_inFlight == 0 && tryConsumeToken(trafficClass, juce::Time::getMillisecondCounterHiRes()))
+        {
+            sendNow = true;
+        }
+        else
+        {
+            bucket.m_queue.push_back(data);
+            m_delayedCount++;
+            if (m_metrics != nullptr)
+                m_metrics->add(Ocp1Metrics::Counter::SendQueueDepth);
+
+            // Started under the lock, timerCallback decides to stop the timer under it as well.
+            if (!isTimerRunning())
+                startTimer(1);
+        }
+    }
+
+    // Sent without holding the lock, a blocking socket write must not stall other senders.
+    if (sendNow)
+        return m_sendFunction && m_sendFunction(data);
+
+    return true;
+}
+
+void Ocp1RateLimiter::clear()
+{
+    const juce::ScopedLock sl(m_bucketLock);
+
+    for (auto& bucket : m_buckets)
+    {
+        if (m_metrics != nullptr)
+            m_metrics->add(Ocp1Metrics::Counter::SendQueueDepth, -static_cast<std::int64_t>(bucket.m_queue.size()));
+        bucket.m_queue.clear();
+    }
+}
+
+std::size_t Ocp1RateLimiter::getQueuedCount(TrafficClass trafficClass) const
+{
+    if (trafficClass == TrafficClass::Unlimited)
+        return 0;
+
+    const juce::ScopedLock sl(m_bucketLock);
+    return m_buckets[static_cast<std::size_t>(trafficClass)].m_queue.size();
+}
+
+std::size_t Ocp1RateLimiter::getQueuedCount() const
+{
+    const juce::ScopedLock sl(m_bucketLock);
+
+    std::size_t queuedCount = 0;
+    for (const auto& bucket : m_buckets)
+        queuedCount += bucket.m_queue.size();
+
+    return queuedCount;
+}
+
+std::uint64_t Ocp1RateLimiter::getDelayedCount() const
+{
+    return m_delayedCount;
+}
+
+std::uint64_t Ocp1RateLimiter::getDroppedCount() const
+{
+    return m_droppedCount;
+}
+
+//==============================================================================
+Ocp1RateLimiter::TrafficClass Ocp1RateLimiter::GetTrafficClass(const ByteVector& data)
+{
+    constexpr std::size_t msgTypeOffset = 7;
+    constexpr std::size_t targetOnoOffset = Ocp1Header::Ocp1HeaderSize + 8; // After command size and handle.
+    constexpr std::size_t methodDefLevelOffset = targetOnoOffset + 4;
+    constexpr std::size_t methodIdxOffset = methodDefLevelOffset + 2;
+    constexpr std::uint32_t subscriptionManagerONo = 0x00000004;
+
+    if (data.size() < methodIdxOffset + 2)
+        return TrafficClass::Unlimited;
+
+    const auto msgType = data[msgTypeOffset];
+    if (msgType != Ocp1Message::Command && msgType != Ocp1Message::CommandResponseRequired)
+        return TrafficClass::Unlimited;
+
+    if (ReadUint32(data.data() + targetOnoOffset) == subscriptionManagerONo)
+        return TrafficClass::Subscription;
+
+    if (ReadUint16(data.data() + methodIdxOffset) == 1) // Get method is usually MethodIdx 1
+        return TrafficClass::Get;
+
+    return TrafficClass::Set;
+}
+
+//==============================================================================
+bool Ocp1RateLimiter::tryConsumeToken(TrafficClass trafficClass, double nowMs)
+{
+    auto& bucket = m_buckets[static_cast<std::size_t>(trafficClass)];
+    if (bucket.m_commandsPerSecond <= 0.0)
+        return true;
+
+    auto elapsedMs = juce::jmax(0.0, nowMs - bucket.m_lastRefillMs);
+    bucket.m_tokens = juce::jmin(bucket.m_burstSize, bucket.m_tokens + elapsedMs * 0.001 * bucket.m_commandsPerSecond);
+    bucket.m_lastRefillMs = nowMs;
+
+    if (bucket.m_tokens < 1.0)
+        return false;
+
+    bucket.m_tokens -= 1.0;
+    return true;
+}
+
+bool Ocp1RateLimiter::sendQueued()
+{
+    // If another thread is flushing already, it takes care of the queues. Waiting for it
+    // would stall this thread on the other one's socket write.
+    const juce::ScopedTryLock fl(m_flushLock);
+    if (!fl.isLocked())
+        return true;
+
+    auto nowMs = juce::Time::getMillisecondCounterHiRes();
+    auto anythingLeft = false;
+
+    for (int i = 0; i < LimitedClassCount; i++)
+    {
+        auto trafficClass = static_cast<TrafficClass>(i);
+        auto& bucket = m_buckets[static_cast<std::size_t>(i)];
+
+        for (;;)
+        {
+            ByteVector data;
+            {
+                const juce::ScopedLock sl(m_bucketLock);
+
+                if (bucket.m_queue.empty() || !tryConsumeToken(trafficClass, nowMs))
+                {
+                    anythingLeft = anythingLeft || !bucket.m_queue.empty();
+                    break;
+                }
+
+                data = std::move(bucket.m_queue.front());
+                bucket.m_queue.pop_front();
+                bucket.m_inFlight++;
+                if (m_metrics != nullptr)
+                    m_metrics->add(Ocp1Metrics::Counter::SendQueueDepth, -1);
+            }
+
+            auto sent = m_sendFunction && m_sendFunction(data);
+            if (!sent)
+                m_droppedCount++;
+
+            const juce::ScopedLock sl(m_bucketLock);
+            bucket.m_inFlight--;
+        }
+    }
+
+    return anythingLeft;
+}
+
+void Ocp1RateLimiter::timerCallback()
+{
+    if (sendQueued())
+        return;
+
+    // A message may have been queued since sendQueued looked at its class. Only stop
+    // if nothing is queued, send() restarts the timer under the same lock otherwise.
+    const juce::ScopedLock sl(m_bucketLock);
+    if (std::all_of(m_buckets.begin(), m_buckets.end(), [](const auto& bucket) { return bucket.m_queue.empty(); }))
+        stopTimer();
+}
+
+
+}
@@ -0,0 +1,141 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+    #include <juce_events/juce_events.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include <deque>
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+class Ocp1Metrics;
+
+//==============================================================================
+/**
+    Token-bucket rate limiter for outgoing OCA commands.
+
+    Commands are classified as Get, Set or subscription traffic, each with its own budget
+    of commands per second plus a burst allowance. Commands exceeding their budget are
+    queued in order and sent as soon as tokens become available again.
+    Anything that is not a command (responses, notifications, KeepAlives) is never limited.
+    Per default all budgets are unlimited.
+*/
+class Ocp1RateLimiter : private juce::Timer
+{
+public:
+    /**
+     * Traffic classes with separate budgets.
+     */
+    enum class TrafficClass
+    {
+        Get = 0,        // Commands using method index 1 (usually GetValue).
+        Set,            // All other commands (SetValue and custom methods).
+        Subscription,   // Commands addressed to the OcaSubscriptionManager.
+        Unlimited       // Anything that is not a command.
+    };
+
+public:
+    //==============================================================================
+    Ocp1RateLimiter(const std::function<bool(const ByteVector&)>& sendFunction, Ocp1Metrics* metrics = nullptr);
+    ~Ocp1RateLimiter() override;
+
+    //==============================================================================
+    /**
+     * Sets the budget for a traffic class.
+     *
+     * @param[in] trafficClass      Traffic class to set the budget for.
+     * @param[in] commandsPerSecond Sustained number of commands per second. 0 means unlimited.
+     * @param[in] burstSize         Number of commands that may be sent back to back after an idle period.
+     */
+    void setBudget(TrafficClass trafficClass, double commandsPerSecond, int burstSize = 1);
+    double getCommandsPerSecond(TrafficClass trafficClass) const;
+
+    //==============================================================================
+    /**
+     * Sends the given message if its traffic class has budget left, otherwise queues it.
+     * Queued messages that fail to be sent once their turn comes are counted as dropped.
+     *
+     * @param[in] data  Serialized OCA message.
+     * @return  True if the message was sent successfully or queued.
+     */
+    bool send(const ByteVector& data);
+
+    /**
+     * Discards all queued messages without sending them.
+     */
+    void clear();
+
+    std::size_t getQueuedCount(TrafficClass trafficClass) const;
+    std::size_t getQueuedCount() const;
+    std::uint64_t getDelayedCount() const;
+    std::uint64_t getDroppedCount() const;
+
+    //==============================================================================
+    /**
+     * Helper to determine the traffic class of a serialized OCA message.
+     *
+     * @param[in] data  Serialized OCA message.
+     * @return  The traffic class the message is accounted for.
+     */
+    static TrafficClass GetTrafficClass(const ByteVector& data);
+
+private:
+    //==============================================================================
+    void timerCallback() override;
+
+    bool tryConsumeToken(TrafficClass trafficClass, double nowMs);
+    bool sendQueued();
+
+    //==============================================================================
+    static constexpr int LimitedClassCount = static_cast<int>(TrafficClass::Unlimited);
+
+    struct TokenBucket
+    {
+        double  m_commandsPerSecond{ 0.0 };     // Refill rate. 0 means unlimited.
+        double  m_burstSize{ 1.0 };             // Maximum number of tokens.
+        double  m_tokens{ 1.0 };                // Currently available tokens.
+        double  m_lastRefillMs{ 0.0 };          // Time of the last refill.
+        std::deque<ByteVector> m_queue;         // Messages waiting for tokens.
+        int     m_inFlight{ 0 };                // Messages taken from the queue, but not sent yet.
+    };
+
+    //==============================================================================
+    std::function<bool(const ByteVector&)>  m_sendFunction;
+
+    juce::CriticalSection                   m_bucketLock;   // Never held while sending.
+    juce::CriticalSection                   m_flushLock;    // Held while sending queued messages, to keep their order.
+    std::array<TokenBucket, LimitedClassCount> m_buckets;
+
+    std::atomic<std::uint64_t>              m_delayedCount{ 0 };
+    std::atomic<std::uint64_t>              m_droppedCount{ 0 };
+    Ocp1Metrics*                            m_metrics{ nullptr };   // Send queue depth is counted here, if set.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1RateLimiter)
+};
+
+}
@@ -0,0 +1,174 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1SetCoalescer.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1SetCoalescer::Ocp1SetCoalescer(const std::function<bool(const ByteVector&)>& sendFunction, int flushRateHz)
+    : m_sendFunction(sendFunction)
+{
+    setFlushRate(flushRateHz);
+}
+
+Ocp1SetCoalescer::~Ocp1SetCoalescer()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void Ocp1SetCoalescer::setFlushRate(int flushRateHz)
+{
+    m_flushRateHz = juce::jmax(0, flushRateHz);
+
+    if (m_flushRateHz > 0)
+    {
+        // The timer only runs while sets are pending, see enqueueSetValue.
+        const juce::ScopedLock sl(m_pendingLock);
+        if (!m_pendingSets.empty())
+            startTimer(juce::jmax(1, 1000 / m_flushRateHz));
+    }
+    else
+    {
+        stopTimer();
+        flush(); // Nothing must stay behind when coalescing is switched off.
+    }
+}
+
+int Ocp1SetCoalescer::getFlushRate() const
+{
+    return m_flushRateHz;
+}
+
+//==============================================================================
+bool Ocp1SetCoalescer::enqueueSetValue(const Ocp1CommandDefinition& def, const Variant& newValue)
+{
+    auto setCommand = def.SetValueCommand(newValue);
+
+    const auto flushRateHz = m_flushRateHz;
+    if (flushRateHz <= 0)
+        return sendSet(setCommand);
+
+    // Use the property addressed by the object definition as key, not the Set command,
+    // since the latter carries the Set method index instead of the property index.
+    const auto propertyKey = def.GetPropertyKey();
+
+    const juce::ScopedLock sl(m_pendingLock);
+
+    auto iter = m_pendingIndices.find(propertyKey);
+    if (iter != m_pendingIndices.end())
+    {
+        m_pendingSets[iter->second].m_command = std::move(setCommand);
+        m_elidedCount++;
+    }
+    else
+    {
+        m_pendingIndices.emplace(propertyKey, m_pendingSets.size());
+        m_pendingSets.push_back({ propertyKey, std::move(setCommand) });
+
+        // Started under the lock, timerCallback decides to stop the timer under it as well.
+        if (!isTimerRunning())
+            startTimer(juce::jmax(1, 1000 / flushRateHz));
+    }
+
+    return true;
+}
+
+bool Ocp1SetCoalescer::flush()
+{
+    std::vector<PendingSet> setsToSend;
+    {
+        const juce::ScopedLock sl(m_pendingLock);
+        setsToSend.swap(m_pendingSets);
+        m_pendingIndices.clear();
+    }
+
+    bool success = true;
+    for (const auto& pendingSet : setsToSend)
+        success = sendSet(pendingSet.m_command) && success;
+
+    return success;
+}
+
+void Ocp1SetCoalescer::clear()
+{
+    const juce::ScopedLock sl(m_pendingLock);
+    m_pendingSets.clear();
+    m_pendingIndices.clear();
+}
+
+//==============================================================================
+std::size_t Ocp1SetCoalescer::getPendingCount() const
+{
+    const juce::ScopedLock sl(m_pendingLock);
+    return m_pendingSets.size();
+}
+
+std::uint64_t Ocp1SetCoalescer::getSentCount() const
+{
+    return m_sentCount;
+}
+
+std::uint64_t Ocp1SetCoalescer::getFailedCount() const
+{
+    return m_failedCount;
+}
+
+std::uint64_t Ocp1SetCoalescer::getElidedCount() const
+{
+    return m_elidedCount;
+}
+
+void Ocp1SetCoalescer::resetCounters()
+{
+    m_sentCount = 0;
+    m_failedCount = 0;
+    m_elidedCount = 0;
+}
+
+//==============================================================================
+bool Ocp1SetCoalescer::sendSet(const Ocp1CommandDefinition& setCommand)
+{
+    std::uint32_t handle;
+    if (m_sendFunction && m_sendFunction(Ocp1CommandResponseRequired(setCommand, handle).GetMemoryBlock()))
+    {
+        m_sentCount++;
+        return true;
+    }
+
+    m_failedCount++;
+    return false;
+}
+
+//==============================================================================
+void Ocp1SetCoalescer::timerCallback()
+{
+    flush();
+
+    // Idle until the next set is enqueued, sets enqueued while flushing keep the timer running.
+    const juce::ScopedLock sl(m_pendingLock);
+    if (m_pendingSets.empty())
+        stopTimer();
+}
+
+
+}
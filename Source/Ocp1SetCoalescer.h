@@ -0,0 +1,115 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+    #include <juce_events/juce_events.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include "Ocp1DataTypes.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Last-value-wins coalescer for outgoing SetValue commands.
+
+    Set commands are queued per addressed property (ONo, defLevel, propIndex). As long as
+    a queued Set was not yet sent, a newer value for the same property replaces it instead
+    of being queued behind it. The queue is flushed at a configurable rate, in the order
+    the properties were first queued, and the flush timer only runs while Sets are queued.
+    A flush rate of 0 disables coalescing and sends every Set immediately.
+*/
+class Ocp1SetCoalescer : private juce::Timer
+{
+public:
+    //==============================================================================
+    Ocp1SetCoalescer(const std::function<bool(const ByteVector&)>& sendFunction, int flushRateHz = 50);
+    ~Ocp1SetCoalescer() override;
+
+    //==============================================================================
+    void setFlushRate(int flushRateHz);
+    int getFlushRate() const;
+
+    //==============================================================================
+    /**
+     * Queues a SetValue command for the property addressed by the given object definition.
+     * A still unsent Set for the same property is replaced by the new value.
+     *
+     * @param[in] def       Object definition to create the SetValue command for.
+     * @param[in] newValue  Value to set.
+     * @return  True if the command was queued (or sent successfully, if coalescing is disabled).
+     */
+    bool enqueueSetValue(const Ocp1CommandDefinition& def, const Variant& newValue);
+
+    /**
+     * Sends all queued Set commands immediately.
+     *
+     * @return  True if all queued commands were sent successfully.
+     */
+    bool flush();
+
+    /**
+     * Discards all queued Set commands without sending them, e.g. when the connection was lost.
+     */
+    void clear();
+
+    //==============================================================================
+    std::size_t getPendingCount() const;
+    std::uint64_t getSentCount() const;
+    std::uint64_t getFailedCount() const;
+    std::uint64_t getElidedCount() const;
+    void resetCounters();
+
+private:
+    //==============================================================================
+    void timerCallback() override;
+
+    bool sendSet(const Ocp1CommandDefinition& setCommand);
+
+    //==============================================================================
+    struct PendingSet
+    {
+        std::uint64_t           m_propertyKey;  // Key of the property addressed by the Set.
+        Ocp1CommandDefinition   m_command;      // Most recent SetValue command for the property.
+    };
+
+    //==============================================================================
+    std::function<bool(const ByteVector&)>  m_sendFunction;
+    int                                     m_flushRateHz{ 0 };
+
+    juce::CriticalSection                   m_pendingLock;
+    std::vector<PendingSet>                 m_pendingSets;      // Ordered by first enqueue time.
+    std::map<std::uint64_t, std::size_t>    m_pendingIndices;   // Property key to index in m_pendingSets.
+
+    std::atomic<std::uint64_t>              m_sentCount{ 0 };   // Set commands passed to the send function successfully.
+    std::atomic<std::uint64_t>              m_failedCount{ 0 }; // Set commands the send function failed for.
+    std::atomic<std::uint64_t>              m_elidedCount{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1SetCoalescer)
+};
+
+}
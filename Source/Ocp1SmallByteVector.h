@@ -0,0 +1,183 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <algorithm>    //< USE std::copy_n, std::fill
+#include <array>        //< USE std::array
+#include <cstdint>      //< USE std::uint8_t
+#include <cstring>      //< USE std::memcmp
+#include <span>         //< USE std::span
+#include <utility>      //< USE std::move
+#include <vector>       //< USE std::vector
+
+namespace NanoOcp1
+{
+
+/**
+ * Byte vector that keeps up to InlineCapacity bytes inside the object and only allocates
+ * for larger contents. Copying or moving short contents therefore never touches the heap,
+ * and large contents can be taken over from a std::vector without copying them.
+ */
+template <std::size_t InlineCapacity>
+class Ocp1SmallByteVector
+{
+    static_assert(InlineCapacity > 0 && InlineCapacity <= 0xff, "The inline size is stored in a single byte");
+
+public:
+    using value_type = std::uint8_t;
+    using size_type = std::size_t;
+    using iterator = std::uint8_t*;
+    using const_iterator = const std::uint8_t*;
+
+    Ocp1SmallByteVector() = default;
+
+    /**
+     * @param[in] size  Number of zero bytes to start with.
+     */
+    explicit Ocp1SmallByteVector(std::size_t size)
+    {
+        resize(size);
+    }
+
+    explicit Ocp1SmallByteVector(std::span<const std::uint8_t> bytes)
+    {
+        assign(bytes);
+    }
+
+    explicit Ocp1SmallByteVector(std::vector<std::uint8_t>&& bytes)
+    {
+        assign(std::move(bytes));
+    }
+
+    //==============================================================================
+    void assign(std::span<const std::uint8_t> bytes)
+    {
+        if (bytes.size() <= InlineCapacity)
+        {
+            std::copy_n(bytes.data(), bytes.size(), m_inline.data());
+            m_inlineSize = static_cast<std::uint8_t>(bytes.size());
+            m_heap.clear();
+        }
+        else
+        {
+            m_heap.assign(bytes.begin(), bytes.end());
+            m_inlineSize = 0;
+        }
+    }
+
+    /**
+     * Takes over the vector's buffer if the bytes do not fit inline.
+     */
+    void assign(std::vector<std::uint8_t>&& bytes)
+    {
+        if (bytes.size() <= InlineCapacity)
+        {
+            assign(std::span<const std::uint8_t>(bytes));
+        }
+        else
+        {
+            m_heap = std::move(bytes);
+            m_inlineSize = 0;
+        }
+    }
+
+    /**
+     * Changes the size, filling new bytes with zeros.
+     */
+    void resize(std::size_t size)
+    {
+        if (size <= InlineCapacity)
+        {
+            if (isInline())
+            {
+                if (size > m_inlineSize)
+                    std::fill(m_inline.begin() + m_inlineSize, m_inline.begin() + size, std::uint8_t(0));
+            }
+            else
+                std::copy_n(m_heap.data(), size, m_inline.data());
+
+            m_inlineSize = static_cast<std::uint8_t>(size);
+            m_heap.clear();
+        }
+        else
+        {
+            if (isInline())
+                m_heap.assign(m_inline.begin(), m_inline.begin() + m_inlineSize);
+
+            m_heap.resize(size);
+            m_inlineSize = 0;
+        }
+    }
+
+    void clear() noexcept
+    {
+        m_heap.clear();
+        m_inlineSize = 0;
+    }
+
+    //==============================================================================
+    std::uint8_t* data() noexcept { return isInline() ? m_inline.data() : m_heap.data(); }
+    const std::uint8_t* data() const noexcept { return isInline() ? m_inline.data() : m_heap.data(); }
+    std::size_t size() const noexcept { return isInline() ? m_inlineSize : m_heap.size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+
+    std::uint8_t& operator[](std::size_t index) noexcept { return data()[index]; }
+    const std::uint8_t& operator[](std::size_t index) const noexcept { return data()[index]; }
+
+    operator std::span<const std::uint8_t>() const noexcept { return { data(), size() }; }
+
+    /**
+     * @return  True if the bytes are stored inside the object rather than on the heap.
+     */
+    bool isInline() const noexcept { return m_heap.empty(); }
+
+    //==============================================================================
+    std::vector<std::uint8_t> toVector() const&
+    {
+        return std::vector<std::uint8_t>(begin(), end());
+    }
+
+    /**
+     * Hands out the heap buffer, if any, instead of copying it.
+     */
+    std::vector<std::uint8_t> toVector() &&
+    {
+        if (isInline())
+            return std::vector<std::uint8_t>(begin(), end());
+
+        return std::move(m_heap);
+    }
+
+    bool operator==(const Ocp1SmallByteVector& other) const noexcept
+    {
+        return size() == other.size() && (empty() || std::memcmp(data(), other.data(), size()) == 0);
+    }
+
+private:
+    std::vector<std::uint8_t>                   m_heap;             // Holds the bytes if they exceed InlineCapacity, empty otherwise.
+    std::array<std::uint8_t, InlineCapacity>    m_inline{};
+    std::uint8_t                                m_inlineSize{ 0 };
+};
+
+}
@@ -0,0 +1,251 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1SubscriptionSet.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+Ocp1SubscriptionSet::Ocp1SubscriptionSet(const SendCommandFunction& sendCommandFunction, int timeoutMs)
+    : m_sendCommandFunction(sendCommandFunction), m_timeoutMs(timeoutMs)
+{
+}
+
+Ocp1SubscriptionSet::~Ocp1SubscriptionSet()
+{
+}
+
+//==============================================================================
+void Ocp1SubscriptionSet::add(std::span<const Ocp1CommandDefinition* const> defs, bool isConnected)
+{
+    std::vector<std::uint32_t> newOnos;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        for (const auto* def : defs)
+        {
+            jassert(def != nullptr);
+            if (def == nullptr || m_subscriptions.count(def->m_targetOno) > 0)
+                continue;
+
+            m_subscriptions.emplace(def->m_targetOno, Subscription{ std::unique_ptr<Ocp1CommandDefinition>(def->Clone()), State::NotSent });
+            newOnos.push_back(def->m_targetOno);
+        }
+    }
+
+    if (isConnected)
+        sendAddSubscriptions(newOnos);
+}
+
+void Ocp1SubscriptionSet::add(const Ocp1CommandDefinition& def, bool isConnected)
+{
+    const Ocp1CommandDefinition* defs[] = { &def };
+    add(defs, isConnected);
+}
+
+void Ocp1SubscriptionSet::remove(const Ocp1CommandDefinition& def, bool isConnected)
+{
+    std::unique_ptr<Ocp1CommandDefinition> removedDef;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        auto iter = m_subscriptions.find(def.m_targetOno);
+        if (iter == m_subscriptions.end())
+            return;
+
+        if (iter->second.m_state == State::Pending)
+            m_pendingCount--;
+
+        removedDef = std::move(iter->second.m_def);
+        m_subscriptions.erase(iter);
+    }
+
+    if (isConnected && m_sendCommandFunction)
+        m_sendCommandFunction(removedDef->RemoveSubscriptionCommand(), nullptr, m_timeoutMs);
+
+    finishRestoreIfComplete();
+}
+
+void Ocp1SubscriptionSet::clear(bool isConnected)
+{
+    std::map<std::uint32_t, Subscription> removedSubscriptions;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+        removedSubscriptions.swap(m_subscriptions);
+        m_pendingCount = 0;
+        m_restoreInProgress = false;
+    }
+
+    if (isConnected && m_sendCommandFunction)
+        for (const auto& subscription : removedSubscriptions)
+            m_sendCommandFunction(subscription.second.m_def->RemoveSubscriptionCommand(), nullptr, m_timeoutMs);
+}
+
+//==============================================================================
+void Ocp1SubscriptionSet::restore()
+{
+    std::vector<std::uint32_t> onos;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        onos.reserve(m_subscriptions.size());
+        for (auto& subscription : m_subscriptions)
+        {
+            subscription.second.m_state = State::NotSent;
+            onos.push_back(subscription.first);
+        }
+
+        m_pendingCount = 0;
+        m_restoreFailedCount = 0;
+        m_restoreInProgress = true;
+        m_restoreStartMs = juce::Time::getMillisecondCounterHiRes();
+        m_lastRestoreDurationMs = -1.0;
+    }
+
+    sendAddSubscriptions(onos);
+
+    // Covers the empty set, which is live right away.
+    finishRestoreIfComplete();
+}
+
+void Ocp1SubscriptionSet::connectionLost()
+{
+    const juce::ScopedLock sl(m_subscriptionLock);
+
+    for (auto& subscription : m_subscriptions)
+        subscription.second.m_state = State::NotSent;
+
+    m_pendingCount = 0;
+    m_restoreInProgress = false;
+}
+
+//==============================================================================
+std::size_t Ocp1SubscriptionSet::getCount() const
+{
+    const juce::ScopedLock sl(m_subscriptionLock);
+    return m_subscriptions.size();
+}
+
+std::size_t Ocp1SubscriptionSet::getCount(State state) const
+{
+    const juce::ScopedLock sl(m_subscriptionLock);
+    return static_cast<std::size_t>(std::count_if(m_subscriptions.begin(), m_subscriptions.end(),
+        [state](const auto& subscription) { return subscription.second.m_state == state; }));
+}
+
+Ocp1SubscriptionSet::State Ocp1SubscriptionSet::getState(const Ocp1CommandDefinition& def) const
+{
+    const juce::ScopedLock sl(m_subscriptionLock);
+
+    auto iter = m_subscriptions.find(def.m_targetOno);
+    if (iter == m_subscriptions.end())
+        return State::NotSent;
+
+    return iter->second.m_state;
+}
+
+bool Ocp1SubscriptionSet::isLive() const
+{
+    return getCount(State::Acknowledged) == getCount();
+}
+
+double Ocp1SubscriptionSet::getLastRestoreDurationMs() const
+{
+    const juce::ScopedLock sl(m_subscriptionLock);
+    return m_lastRestoreDurationMs;
+}
+
+//==============================================================================
+void Ocp1SubscriptionSet::sendAddSubscriptions(const std::vector<std::uint32_t>& onos)
+{
+    if (!m_sendCommandFunction)
+        return;
+
+    // Commands are created upfront, to not hold the lock while sending.
+    std::vector<std::pair<std::uint32_t, Ocp1CommandDefinition>> commands;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        commands.reserve(onos.size());
+        for (auto ono : onos)
+        {
+            auto iter = m_subscriptions.find(ono);
+            if (iter == m_subscriptions.end())
+                continue;
+
+            if (iter->second.m_state != State::Pending)
+                m_pendingCount++;
+
+            iter->second.m_state = State::Pending;
+            commands.emplace_back(ono, iter->second.m_def->AddSubscriptionCommand());
+        }
+    }
+
+    // Send everything as one burst, acknowledgements are collected as they come in.
+    for (const auto& command : commands)
+    {
+        auto ono = command.first;
+        if (!m_sendCommandFunction(command.second, [this, ono](const Ocp1Response* response) { handleAcknowledgement(ono, response); }, m_timeoutMs))
+            handleAcknowledgement(ono, nullptr);
+    }
+}
+
+void Ocp1SubscriptionSet::handleAcknowledgement(std::uint32_t ono, const Ocp1Response* response)
+{
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        auto iter = m_subscriptions.find(ono);
+        if (iter == m_subscriptions.end() || iter->second.m_state != State::Pending)
+            return; // Removed in the meantime, or a late response from before a reconnect.
+
+        auto acknowledged = (response != nullptr && response->GetResponseStatus() == OCASTATUS_OK);
+        iter->second.m_state = acknowledged ? State::Acknowledged : State::Failed;
+
+        m_pendingCount--;
+        if (!acknowledged && m_restoreInProgress)
+            m_restoreFailedCount++;
+    }
+
+    finishRestoreIfComplete();
+}
+
+void Ocp1SubscriptionSet::finishRestoreIfComplete()
+{
+    double restoreDurationMs = 0.0;
+    std::size_t failedCount = 0;
+    {
+        const juce::ScopedLock sl(m_subscriptionLock);
+
+        if (!m_restoreInProgress || m_pendingCount > 0)
+            return;
+
+        m_restoreInProgress = false;
+        m_lastRestoreDurationMs = juce::Time::getMillisecondCounterHiRes() - m_restoreStartMs;
+        restoreDurationMs = m_lastRestoreDurationMs;
+        failedCount = m_restoreFailedCount;
+    }
+
+    if (onRestoreComplete)
+        onRestoreComplete(restoreDurationMs, failedCount);
+}
+
+}
@@ -0,0 +1,150 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include <span>
+
+#include "Ocp1CommandTracker.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Set of object subscriptions owned by a client connection.
+
+    Subscriptions are kept per object (ONo), since the AddSubscription command subscribes
+    to the PropertyChanged event of an object as a whole. Whenever the set is (re)sent,
+    all AddSubscription commands go out as one pipelined burst and the acknowledging
+    responses are tracked per object. After a reconnect the whole set is replayed and
+    the time until every subscription is acknowledged is measured.
+*/
+class Ocp1SubscriptionSet
+{
+public:
+    using SendCommandFunction = std::function<bool(const Ocp1CommandDefinition&, const Ocp1CommandTracker::ResponseCallback&, int)>;
+
+    /**
+     * Acknowledgement state of a single subscription.
+     */
+    enum class State
+    {
+        NotSent = 0,    // Not sent to the device yet, e.g. because there is no connection.
+        Pending,        // AddSubscription sent, response outstanding.
+        Acknowledged,   // Device confirmed the subscription.
+        Failed          // Device rejected the subscription or did not respond in time.
+    };
+
+public:
+    //==============================================================================
+    Ocp1SubscriptionSet(const SendCommandFunction& sendCommandFunction, int timeoutMs = 2000);
+    ~Ocp1SubscriptionSet();
+
+    //==============================================================================
+    /**
+     * Adds the object of each given definition to the set. Objects already contained are skipped.
+     * If connected, the AddSubscription commands for the new objects are sent as one burst.
+     *
+     * @param[in] defs          Object definitions to subscribe to.
+     * @param[in] isConnected   True if the commands can be sent right away.
+     */
+    void add(std::span<const Ocp1CommandDefinition* const> defs, bool isConnected);
+    void add(const Ocp1CommandDefinition& def, bool isConnected);
+
+    /**
+     * Removes the object of the given definition from the set.
+     * If connected, the RemoveSubscription command is sent.
+     */
+    void remove(const Ocp1CommandDefinition& def, bool isConnected);
+
+    /**
+     * Removes all objects from the set. If connected, the RemoveSubscription commands are sent.
+     */
+    void clear(bool isConnected);
+
+    //==============================================================================
+    /**
+     * Sends the whole set as one burst, e.g. after the connection was (re)established,
+     * and starts measuring the time until all subscriptions are acknowledged.
+     */
+    void restore();
+
+    /**
+     * Marks all subscriptions as not sent, since the device forgets them with the connection.
+     */
+    void connectionLost();
+
+    //==============================================================================
+    std::size_t getCount() const;
+    std::size_t getCount(State state) const;
+    State getState(const Ocp1CommandDefinition& def) const;
+    bool isLive() const;
+
+    /**
+     * Time it took from the last call to restore until all subscriptions were acknowledged
+     * (or had failed), in milliseconds. Negative if the last restore is still in progress.
+     */
+    double getLastRestoreDurationMs() const;
+
+    //==============================================================================
+    /**
+     * Invoked when all subscriptions sent by restore got a response (or timed out).
+     * Parameters are the restore duration in milliseconds and the number of failed subscriptions.
+     */
+    std::function<void(double, std::size_t)> onRestoreComplete;
+
+private:
+    //==============================================================================
+    struct Subscription
+    {
+        std::unique_ptr<Ocp1CommandDefinition>  m_def;
+        State                                   m_state{ State::NotSent };
+    };
+
+    //==============================================================================
+    void sendAddSubscriptions(const std::vector<std::uint32_t>& onos);
+    void handleAcknowledgement(std::uint32_t ono, const Ocp1Response* response);
+    void finishRestoreIfComplete();
+
+    //==============================================================================
+    SendCommandFunction                         m_sendCommandFunction;
+    int                                         m_timeoutMs{ 2000 };
+
+    juce::CriticalSection                       m_subscriptionLock;
+    std::map<std::uint32_t, Subscription>       m_subscriptions;    // Keyed by ONo.
+
+    std::size_t                                 m_pendingCount{ 0 };        // Subscriptions in State::Pending.
+    std::size_t                                 m_restoreFailedCount{ 0 };  // Subscriptions failed since the last restore.
+    bool                                        m_restoreInProgress{ false };
+    double                                      m_restoreStartMs{ 0.0 };
+    double                                      m_lastRestoreDurationMs{ -1.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1SubscriptionSet)
+};
+
+}
@@ -0,0 +1,256 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1WireCapture.h"
+#include "Ocp1CaptureFile.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+struct Ocp1WireCapture::ErrorDumpThread : public juce::Thread
+{
+    ErrorDumpThread(Ocp1WireCapture& c) : juce::Thread("NanoOcp1 error dump"), owner(c) {}
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(-1);
+            owner.writeRequestedErrorDumps();
+        }
+    }
+
+    Ocp1WireCapture& owner;
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ErrorDumpThread)
+};
+
+//==============================================================================
+Ocp1WireCapture::Ocp1WireCapture(std::size_t slotCount, std::size_t slotSize)
+    : m_slotCount(static_cast<std::size_t>(juce::nextPowerOfTwo(static_cast<int>(juce::jmax(std::size_t(1), slotCount))))),
+    m_slotWords((juce::jmax(std::size_t(8), slotSize) + 7) / 8)
+{
+    m_slots = std::make_unique<Slot[]>(m_slotCount);
+    m_data = std::make_unique<std::atomic<std::uint64_t>[]>(m_slotCount * m_slotWords);
+}
+
+Ocp1WireCapture::~Ocp1WireCapture()
+{
+    if (m_errorDumpThread != nullptr)
+        m_errorDumpThread->stopThread(4000);
+}
+
+//==============================================================================
+void Ocp1WireCapture::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Ocp1WireCapture::isEnabled() const
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+void Ocp1WireCapture::capture(Direction direction, const std::uint8_t* data, std::size_t size)
+{
+    if (!m_enabled.load(std::memory_order_relaxed))
+        return;
+
+    auto index = m_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[static_cast<std::size_t>(index & (m_slotCount - 1))];
+    auto* words = m_data.get() + static_cast<std::size_t>(index & (m_slotCount - 1)) * m_slotWords;
+
+    slot.m_sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.m_ticks.store(juce::Time::getHighResolutionTicks(), std::memory_order_relaxed);
+    slot.m_size.store(static_cast<std::uint32_t>(size), std::memory_order_relaxed);
+    slot.m_direction.store(static_cast<std::uint8_t>(direction), std::memory_order_relaxed);
+
+    auto capturedSize = juce::jmin(size, m_slotWords * 8);
+    for (std::size_t offset = 0; offset < capturedSize; offset += 8)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + offset, juce::jmin(std::size_t(8), capturedSize - offset));
+        words[offset / 8].store(word, std::memory_order_relaxed);
+    }
+
+    slot.m_sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void Ocp1WireCapture::clear()
+{
+    m_clearIndex.store(m_writeIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::vector<Ocp1WireCapture::Record> Ocp1WireCapture::getRecords() const
+{
+    auto index = m_clearIndex.load(std::memory_order_relaxed);
+    return getRecordsSince(index);
+}
+
+std::vector<Ocp1WireCapture::Record> Ocp1WireCapture::getRecordsSince(std::uint64_t& index, std::uint64_t* pDropped) const
+{
+    auto endIndex = m_writeIndex.load(std::memory_order_acquire);
+    auto beginIndex = juce::jmax(index, endIndex > m_slotCount ? endIndex - m_slotCount : 0);
+
+    std::vector<Record> records;
+    records.reserve(static_cast<std::size_t>(endIndex - beginIndex));
+
+    for (auto i = beginIndex; i < endIndex; i++)
+    {
+        const auto& slot = m_slots[static_cast<std::size_t>(i & (m_slotCount - 1))];
+        const auto* words = m_data.get() + static_cast<std::size_t>(i & (m_slotCount - 1)) * m_slotWords;
+
+        // Skip records still being written or already overwritten.
+        auto sequence = slot.m_sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * i + 2)
+            continue;
+
+        Record record;
+        record.m_ticks = slot.m_ticks.load(std::memory_order_relaxed);
+        record.m_size = slot.m_size.load(std::memory_order_relaxed);
+        record.m_direction = static_cast<Direction>(slot.m_direction.load(std::memory_order_relaxed));
+
+        auto capturedSize = juce::jmin(static_cast<std::size_t>(record.m_size), m_slotWords * 8);
+        record.m_data.resize(capturedSize);
+        for (std::size_t offset = 0; offset < capturedSize; offset += 8)
+        {
+            auto word = words[offset / 8].load(std::memory_order_relaxed);
+            std::memcpy(record.m_data.data() + offset, &word, juce::jmin(std::size_t(8), capturedSize - offset));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.m_sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        records.push_back(std::move(record));
+    }
+
+    if (pDropped != nullptr)
+        *pDropped = (endIndex - juce::jmin(index, endIndex)) - records.size();
+
+    index = endIndex;
+    return records;
+}
+
+std::uint64_t Ocp1WireCapture::getCapturedCount() const
+{
+    return m_writeIndex.load(std::memory_order_relaxed);
+}
+
+std::size_t Ocp1WireCapture::getSlotCount() const
+{
+    return m_slotCount;
+}
+
+std::size_t Ocp1WireCapture::getSlotSize() const
+{
+    return m_slotWords * 8;
+}
+
+//==============================================================================
+bool Ocp1WireCapture::dumpToFile(const juce::File& file) const
+{
+    auto records = getRecords();
+
+    // Relate the monotonic capture ticks to wall clock time.
+    auto startTicks = records.empty() ? juce::Time::getHighResolutionTicks() : records.front().m_ticks;
+    auto startMs = Ocp1CaptureWriter::TicksToTimeMillis(startTicks);
+
+    Ocp1CaptureWriter writer(file, startMs);
+    if (!writer.isOk())
+        return false;
+
+    for (const auto& record : records)
+        if (!writer.write(record, startTicks))
+            return false;
+
+    return writer.flush();
+}
+
+void Ocp1WireCapture::setErrorDumpDirectory(const juce::File& directory, int minErrorDumpIntervalMs)
+{
+    const juce::ScopedLock sl(m_errorDumpLock);
+    m_errorDumpDirectory = directory;
+    m_minErrorDumpIntervalMs = juce::jmax(0, minErrorDumpIntervalMs);
+
+    if (directory != juce::File() && m_errorDumpThread == nullptr)
+    {
+        m_errorDumpThread = std::make_unique<ErrorDumpThread>(*this);
+        m_errorDumpThread->startThread(juce::Thread::Priority::background);
+    }
+
+    m_errorDumpEnabled.store(directory != juce::File(), std::memory_order_relaxed);
+}
+
+juce::File Ocp1WireCapture::dumpOnError(const juce::String& reason) const
+{
+    juce::File directory;
+    {
+        const juce::ScopedLock sl(m_errorDumpLock);
+        directory = m_errorDumpDirectory;
+    }
+
+    if (directory == juce::File() || directory.createDirectory().failed())
+        return {};
+
+    auto fileName = "NanoOcp1_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S") + "_" + reason;
+    auto file = directory.getNonexistentChildFile(juce::File::createLegalFileName(fileName), ".nocp", false);
+    if (!dumpToFile(file))
+        return {};
+
+    return file;
+}
+
+bool Ocp1WireCapture::requestErrorDump(const juce::String& reason)
+{
+    if (!m_errorDumpEnabled.load(std::memory_order_relaxed))
+        return false;
+
+    {
+        const juce::ScopedLock sl(m_errorDumpLock);
+
+        auto nowMs = juce::Time::getMillisecondCounterHiRes();
+        auto lastDump = m_lastErrorDumpMs.find(reason);
+        if (lastDump != m_lastErrorDumpMs.end() && nowMs - lastDump->second < m_minErrorDumpIntervalMs)
+            return false;
+
+        m_lastErrorDumpMs[reason] = nowMs;
+        m_requestedErrorDumps.add(reason);
+    }
+
+    m_errorDumpThread->notify();
+    return true;
+}
+
+void Ocp1WireCapture::writeRequestedErrorDumps()
+{
+    juce::StringArray reasons;
+    {
+        const juce::ScopedLock sl(m_errorDumpLock);
+        reasons.swapWith(m_requestedErrorDumps);
+    }
+
+    for (const auto& reason : reasons)
+        dumpOnError(reason);
+}
+
+}
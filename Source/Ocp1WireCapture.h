@@ -0,0 +1,191 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#ifdef JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED
+    #include <juce_core/juce_core.h>
+#else
+    #include <JuceHeader.h>
+#endif
+
+#include <map>
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+
+//==============================================================================
+/**
+    Fixed size ring of the most recently sent and received raw OCA messages.
+
+    Capturing is lock free and meant to be always on: a message costs one atomic increment
+    to claim a slot plus a copy of at most the slot size, so it neither blocks nor allocates.
+    Messages larger than a slot are truncated, their original size is kept. Once the ring
+    is full the oldest records are overwritten.
+
+    The ring can be read at any time, e.g. to dump it to a capture file (see Ocp1CaptureFile.h)
+    on demand or when an error was detected (see setErrorDumpDirectory), or continuously by a
+    Ocp1CaptureRecorder. Records still being written or overwritten while being read are skipped.
+*/
+class Ocp1WireCapture
+{
+public:
+    enum class Direction : std::uint8_t
+    {
+        Received = 0,
+        Sent
+    };
+
+    /**
+     * A single captured message, as read back from the ring.
+     */
+    struct Record
+    {
+        std::int64_t    m_ticks{ 0 };       // juce::Time::getHighResolutionTicks when captured.
+        Direction       m_direction{ Direction::Received };
+        std::uint32_t   m_size{ 0 };        // Original size of the message.
+        ByteVector      m_data;             // Captured bytes, at most the slot size.
+
+        bool isTruncated() const { return m_data.size() < m_size; }
+    };
+
+public:
+    //==============================================================================
+    /**
+     * Class constructor.
+     *
+     * @param[in] slotCount     Number of messages kept, rounded up to a power of two.
+     * @param[in] slotSize      Number of bytes kept per message, rounded up to a multiple of 8.
+     */
+    explicit Ocp1WireCapture(std::size_t slotCount = 1024, std::size_t slotSize = 256);
+    ~Ocp1WireCapture();
+
+    //==============================================================================
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * Records the given message. Safe to call from any number of threads at once.
+     */
+    void capture(Direction direction, const std::uint8_t* data, std::size_t size);
+    void capture(Direction direction, const ByteVector& data) { capture(direction, data.data(), data.size()); }
+
+    /**
+     * Drops everything captured so far.
+     */
+    void clear();
+
+    //==============================================================================
+    /**
+     * Gets a copy of the captured records, oldest first.
+     */
+    std::vector<Record> getRecords() const;
+
+    /**
+     * Gets a copy of the records captured since the given capture index, oldest first.
+     *
+     * @param[in,out] index     Capture index to start at, set to the index of the next capture on return.
+     * @param[out] pDropped     Optional. Number of records overwritten or torn before they could be read.
+     */
+    std::vector<Record> getRecordsSince(std::uint64_t& index, std::uint64_t* pDropped = nullptr) const;
+
+    /**
+     * Total number of messages captured since construction, including the overwritten ones.
+     */
+    std::uint64_t getCapturedCount() const;
+
+    std::size_t getSlotCount() const;
+    std::size_t getSlotSize() const;
+
+    //==============================================================================
+    /**
+     * Writes the captured records to the given capture file, replacing its contents.
+     */
+    bool dumpToFile(const juce::File& file) const;
+
+    /**
+     * Sets the directory dumpOnError and requestErrorDump write to. An invalid File disables dumping on error, which is the default.
+     *
+     * @param[in] directory                 Directory to write the dumps to.
+     * @param[in] minErrorDumpIntervalMs    Shortest time between two requested dumps for the same reason.
+     */
+    void setErrorDumpDirectory(const juce::File& directory, int minErrorDumpIntervalMs = 10000);
+
+    /**
+     * Dumps the captured records to a new file in the error dump directory, if one is set.
+     *
+     * @param[in] reason    Short description of the error, becomes part of the file name.
+     * @return  The file written, or an invalid File if nothing was written.
+     */
+    juce::File dumpOnError(const juce::String& reason) const;
+
+    /**
+     * Has dumpOnError called for the given reason on a background thread, so the thread that detected
+     * the error does not block on writing the file. A reason dumped less than the minimum interval ago
+     * is not dumped again, a desynchronised stream would otherwise request a dump for every read.
+     *
+     * @param[in] reason    Short description of the error, becomes part of the file name.
+     * @return  True if a dump was scheduled.
+     */
+    bool requestErrorDump(const juce::String& reason);
+
+private:
+    //==============================================================================
+    struct ErrorDumpThread;
+
+    void writeRequestedErrorDumps();
+
+    //==============================================================================
+    /**
+     * Seqlock protected slot. The sequence is odd while a capture writes the slot,
+     * and 2 * (capture index + 1) once it is complete.
+     */
+    struct Slot
+    {
+        std::atomic<std::uint64_t>  m_sequence{ 0 };
+        std::atomic<std::int64_t>   m_ticks{ 0 };
+        std::atomic<std::uint32_t>  m_size{ 0 };
+        std::atomic<std::uint8_t>   m_direction{ 0 };
+    };
+
+    //==============================================================================
+    std::size_t                                     m_slotCount{ 0 };
+    std::size_t                                     m_slotWords{ 0 };   // Slot size in 64 bit words.
+    std::unique_ptr<Slot[]>                         m_slots;
+    std::unique_ptr<std::atomic<std::uint64_t>[]>   m_data;             // m_slotWords per slot.
+
+    std::atomic<std::uint64_t>                      m_writeIndex{ 0 };  // Index of the next capture.
+    std::atomic<std::uint64_t>                      m_clearIndex{ 0 };  // Captures before this index were cleared.
+    std::atomic<bool>                               m_enabled{ true };
+
+    juce::CriticalSection                           m_errorDumpLock;
+    juce::File                                      m_errorDumpDirectory;
+    std::atomic<bool>                               m_errorDumpEnabled{ false };
+    int                                             m_minErrorDumpIntervalMs{ 10000 };
+    std::map<juce::String, double>                  m_lastErrorDumpMs;      // Time of the last requested dump per reason.
+    juce::StringArray                               m_requestedErrorDumps;  // Reasons waiting to be dumped.
+    std::unique_ptr<ErrorDumpThread>                m_errorDumpThread;      // Created along with the first error dump directory.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ocp1WireCapture)
+};
+
+}
@@ -17,49 +17,97 @@
  */
 
 #include "Variant.h"
+#include "Ocp1Codec.h"
 #include <assert.h>
-#include <sstream>
+#include <charconv>
 
 
 namespace NanoOcp1
 {
 
+namespace
+{
+
+/**
+ * Formats the values as a comma separated list, each like std::ostream does by default,
+ * but without the overhead of a std::stringstream.
+ */
+template <std::size_t N>
+std::string ToCommaSeparatedString(const std::array<std::float_t, N>& values)
+{
+    std::array<char, N * 16> buffer; // Up to 12 characters per value, e.g. "-1.17549e-38", plus ", ".
+    auto pos = buffer.data();
+    for (std::size_t i = 0; i < N; i++)
+    {
+        if (i > 0)
+        {
+            *pos++ = ',';
+            *pos++ = ' ';
+        }
+        pos = std::to_chars(pos, buffer.data() + buffer.size(), values[i], std::chars_format::general, 6).ptr;
+    }
+
+    return std::string(buffer.data(), pos);
+}
+
+}
+
 Variant::Variant(bool v) { m_value = v; }
+Variant::Variant(std::int8_t v) { m_value = v; }
+Variant::Variant(std::int16_t v) { m_value = v; }
 Variant::Variant(std::int32_t v) { m_value = v; }
+Variant::Variant(std::int64_t v) { m_value = v; }
 Variant::Variant(std::uint8_t v) { m_value = v; }
 Variant::Variant(std::uint16_t v) { m_value = v; }
 Variant::Variant(std::uint32_t v) { m_value = v; }
 Variant::Variant(std::uint64_t v) { m_value = v; }
 Variant::Variant(std::float_t v) { m_value = v; }
 Variant::Variant(std::double_t v) { m_value = v; }
-Variant::Variant(const std::string& v) { m_value = v; }
-Variant::Variant(const char* v) : Variant(std::string(v)) { } // Allow Variant("test") to become of TypeString.
-
-Variant::Variant(std::float_t x, std::float_t y, std::float_t z)
-{
-    assert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work below
-    std::uint32_t xInt = *(std::uint32_t*)&x;
-    std::uint32_t yInt = *(std::uint32_t*)&y;
-    std::uint32_t zInt = *(std::uint32_t*)&z;
-
-    m_value = std::vector<std::uint8_t>
-        ({
-            static_cast<std::uint8_t>(xInt >> 24),
-            static_cast<std::uint8_t>(xInt >> 16),
-            static_cast<std::uint8_t>(xInt >> 8),
-            static_cast<std::uint8_t>(xInt),
-            static_cast<std::uint8_t>(yInt >> 24),
-            static_cast<std::uint8_t>(yInt >> 16),
-            static_cast<std::uint8_t>(yInt >> 8),
-            static_cast<std::uint8_t>(yInt),
-            static_cast<std::uint8_t>(zInt >> 24),
-            static_cast<std::uint8_t>(zInt >> 16),
-            static_cast<std::uint8_t>(zInt >> 8),
-            static_cast<std::uint8_t>(zInt),
-        });
+Variant::Variant(const std::string& v) : Variant(std::string_view(v)) { }
+Variant::Variant(std::string_view v) { m_value = StringData{ Bytes(std::span(reinterpret_cast<const std::uint8_t*>(v.data()), v.size())) }; }
+Variant::Variant(const char* v) : Variant(std::string_view(v)) { } // Allow Variant("test") to become of TypeString.
+
+Variant::Variant(std::float_t x, std::float_t y, std::float_t z) : Variant(Ocp1Position{ x, y, z }) { }
+
+Variant::Variant(const Ocp1Position& v)
+{
+    // Marshaled straight into the inline storage, without a temporary byte vector.
+    Bytes data(NanoOcp1::Ocp1Codec<Ocp1Position>::Size);
+    NanoOcp1::Ocp1Codec<Ocp1Position>::Encode(std::span(data.data(), data.size()), v);
+    m_value = std::move(data);
+}
+
+Variant::Variant(const Ocp1AimingAndPosition& v)
+{
+    Bytes data(NanoOcp1::Ocp1Codec<Ocp1AimingAndPosition>::Size);
+    NanoOcp1::Ocp1Codec<Ocp1AimingAndPosition>::Encode(std::span(data.data(), data.size()), v);
+    m_value = std::move(data);
+}
+
+Variant::Variant(const Ocp1BitStringView& v)
+{
+    Bytes data(NanoOcp1::Ocp1Codec<Ocp1BitStringView>::GetSize(v));
+    if (NanoOcp1::Ocp1Codec<Ocp1BitStringView>::Encode(std::span(data.data(), data.size()), v) == 0)
+        data.clear();
+
+    m_value = MarshaledData<OCP1DATATYPE_BIT_STRING>{ std::move(data) };
 }
 
 Variant::Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type)
+    : Variant(std::span<const std::uint8_t>(data), type)
+{
+}
+
+Variant::Variant(std::vector<std::uint8_t>&& data, Ocp1DataType type)
+{
+    // Only TypeByteVector can take over the data's buffer, everything else is unmarshaled as usual.
+    if ((type == OCP1DATATYPE_BLOB || type == OCP1DATATYPE_DB_POSITION) && IsValidByteVector(data, type))
+        m_value = Bytes(std::move(data));
+    else
+        *this = Variant(std::span<const std::uint8_t>(data), type);
+}
+
+Variant::Variant(std::span<const std::uint8_t> data, Ocp1DataType type)
 {
     bool ok(false);
     switch (type)
@@ -67,9 +115,18 @@ Variant::Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type)
         case OCP1DATATYPE_BOOLEAN:
             m_value = NanoOcp1::DataToBool(data, &ok);
             break;
+        case OCP1DATATYPE_INT8:
+            m_value = NanoOcp1::DataToInt8(data, &ok);
+            break;
+        case OCP1DATATYPE_INT16:
+            m_value = NanoOcp1::DataToInt16(data, &ok);
+            break;
         case OCP1DATATYPE_INT32:
             m_value = NanoOcp1::DataToInt32(data, &ok);
             break;
+        case OCP1DATATYPE_INT64:
+            m_value = NanoOcp1::DataToInt64(data, &ok);
+            break;
         case OCP1DATATYPE_UINT8:
             m_value = NanoOcp1::DataToUint8(data, &ok);
             break;
@@ -89,31 +146,35 @@ Variant::Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type)
             m_value = NanoOcp1::DataToDouble(data, &ok);
             break;
         case OCP1DATATYPE_STRING:
-            m_value = NanoOcp1::DataToString(data, &ok);
+            ok = (data.size() >= 2); // At least 2 bytes for the string length, see DataToString.
+            if (ok)
+                m_value = StringData{ Bytes(data.subspan(2)) };
+            break;
+        case OCP1DATATYPE_BIT_STRING:
+            {
+                Ocp1BitStringView bits;
+                ok = (NanoOcp1::Ocp1Codec<Ocp1BitStringView>::Decode(data, bits) > 0);
+                if (ok)
+                    m_value = MarshaledData<OCP1DATATYPE_BIT_STRING>{ Bytes(data) };
+            }
             break;
         case OCP1DATATYPE_BLOB:
-            ok = (data.size() >= 2); // OcaBlob size is 2 bytes
+        case OCP1DATATYPE_DB_POSITION:
+            // TODO: include 2 initial bytes of OcaBlob?
+            ok = IsValidByteVector(data, type);
             if (ok)
             {
-                // TODO: include 2 initial bytes?
-                m_value = data;
+                m_value = Bytes(data);
             }
             break;
-        case OCP1DATATYPE_DB_POSITION:
-            ok = (data.size() == 12) || // Notification contains 3 floats: x, y, z.
-                 (data.size() == 24) || // Notification contains 6 floats: x, y, z, hor, vert, rot.
-                 (data.size() == 36);   // Response contains 9 floats: current, min, and max x, y, z.
+        case OCP1DATATYPE_BLOB_FIXED_LEN:
+            ok = !data.empty(); // The length is defined by the property, not marshaled.
             if (ok)
             {
-                m_value = data;
+                m_value = MarshaledData<OCP1DATATYPE_BLOB_FIXED_LEN>{ Bytes(data) };
             }
             break;
         case OCP1DATATYPE_NONE:
-        case OCP1DATATYPE_INT8:
-        case OCP1DATATYPE_INT16:
-        case OCP1DATATYPE_INT64:
-        case OCP1DATATYPE_BIT_STRING:
-        case OCP1DATATYPE_BLOB_FIXED_LEN:
         case OCP1DATATYPE_CUSTOM:
         default:
             break;
@@ -122,6 +183,16 @@ Variant::Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type)
     assert(ok); // Conversion not possible or not yet implemented!
 }
 
+bool Variant::IsValidByteVector(std::span<const std::uint8_t> data, Ocp1DataType type)
+{
+    if (type == OCP1DATATYPE_DB_POSITION)
+        return (data.size() == 12) || // Notification contains 3 floats: x, y, z.
+               (data.size() == 24) || // Notification contains 6 floats: x, y, z, hor, vert, rot.
+               (data.size() == 36);   // Response contains 9 floats: current, min, and max x, y, z.
+
+    return (data.size() >= 2); // OcaBlob size is 2 bytes
+}
+
 bool Variant::operator==(const Variant& other) const
 {
     return m_value == other.m_value;
@@ -142,7 +213,10 @@ Ocp1DataType Variant::GetDataType() const
     switch (m_value.index())
     {
         case TypeBool:          return OCP1DATATYPE_BOOLEAN;
+        case TypeInt8:          return OCP1DATATYPE_INT8;
+        case TypeInt16:         return OCP1DATATYPE_INT16;
         case TypeInt32:         return OCP1DATATYPE_INT32;
+        case TypeInt64:         return OCP1DATATYPE_INT64;
         case TypeUInt8:         return OCP1DATATYPE_UINT8;
         case TypeUInt16:        return OCP1DATATYPE_UINT16;
         case TypeUInt32:        return OCP1DATATYPE_UINT32;
@@ -150,7 +224,9 @@ Ocp1DataType Variant::GetDataType() const
         case TypeFloat:         return OCP1DATATYPE_FLOAT32;
         case TypeDouble:        return OCP1DATATYPE_FLOAT64;
         case TypeString:        return OCP1DATATYPE_STRING;
+        case TypeBitString:     return OCP1DATATYPE_BIT_STRING;
         case TypeByteVector:    return OCP1DATATYPE_BLOB;
+        case TypeBlobFixedLen:  return OCP1DATATYPE_BLOB_FIXED_LEN;
         default:
             break;
     }
@@ -166,8 +242,14 @@ bool Variant::ToBool(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value);
+        case TypeInt8:
+            return (std::get<std::int8_t>(m_value) > std::int8_t(0));
+        case TypeInt16:
+            return (std::get<std::int16_t>(m_value) > std::int16_t(0));
         case TypeInt32:
             return (std::get<std::int32_t>(m_value) > std::int32_t(0));
+        case TypeInt64:
+            return (std::get<std::int64_t>(m_value) > std::int64_t(0));
         case TypeUInt8:
             return (std::get<std::uint8_t>(m_value) > std::uint8_t(0));
         case TypeUInt16:
@@ -181,9 +263,9 @@ bool Variant::ToBool(bool* pOk) const
         case TypeDouble:
             return (std::get<std::double_t>(m_value) > std::double_t(0.0));
         case TypeString:
-            return (std::get<std::string>(m_value) == "true");
+            return (std::get<StringData>(m_value).GetView() == "true");
         case TypeByteVector:
-            return DataToBool(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToBool(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -194,6 +276,104 @@ bool Variant::ToBool(bool* pOk) const
     return false;
 }
 
+std::int8_t Variant::ToInt8(bool* pOk) const
+{
+    if (pOk != nullptr) *pOk = true;
+
+    switch (m_value.index())
+    {
+        case TypeBool:
+            return std::get<bool>(m_value) ? std::int8_t(1) : std::int8_t(0);
+        case TypeInt8:
+            return std::get<std::int8_t>(m_value);
+        case TypeInt16:
+            return static_cast<std::int8_t>(std::get<std::int16_t>(m_value));
+        case TypeInt32:
+            return static_cast<std::int8_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::int8_t>(std::get<std::int64_t>(m_value));
+        case TypeUInt8:
+            return static_cast<std::int8_t>(std::get<std::uint8_t>(m_value));
+        case TypeUInt16:
+            return static_cast<std::int8_t>(std::get<std::uint16_t>(m_value));
+        case TypeUInt32:
+            return static_cast<std::int8_t>(std::get<std::uint32_t>(m_value));
+        case TypeUInt64:
+            return static_cast<std::int8_t>(std::get<std::uint64_t>(m_value));
+        case TypeFloat:
+            return static_cast<std::int8_t>(std::lround(std::get<std::float_t>(m_value)));
+        case TypeDouble:
+            return static_cast<std::int8_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeString:
+            try 
+            { 
+                return static_cast<std::int8_t>(std::stoi(std::get<StringData>(m_value).GetString())); 
+            } 
+            catch (...) 
+            { 
+                break; 
+            }
+        case TypeByteVector:
+            return DataToInt8(std::get<Bytes>(m_value), pOk);
+        default:
+            break;
+    }
+
+    // Conversion not possible or not yet implemented!
+    if (pOk != nullptr) *pOk = false;
+
+    return std::int8_t(0);
+}
+
+std::int16_t Variant::ToInt16(bool* pOk) const
+{
+    if (pOk != nullptr) *pOk = true;
+
+    switch (m_value.index())
+    {
+        case TypeBool:
+            return std::get<bool>(m_value) ? std::int16_t(1) : std::int16_t(0);
+        case TypeInt8:
+            return static_cast<std::int16_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return std::get<std::int16_t>(m_value);
+        case TypeInt32:
+            return static_cast<std::int16_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::int16_t>(std::get<std::int64_t>(m_value));
+        case TypeUInt8:
+            return static_cast<std::int16_t>(std::get<std::uint8_t>(m_value));
+        case TypeUInt16:
+            return static_cast<std::int16_t>(std::get<std::uint16_t>(m_value));
+        case TypeUInt32:
+            return static_cast<std::int16_t>(std::get<std::uint32_t>(m_value));
+        case TypeUInt64:
+            return static_cast<std::int16_t>(std::get<std::uint64_t>(m_value));
+        case TypeFloat:
+            return static_cast<std::int16_t>(std::lround(std::get<std::float_t>(m_value)));
+        case TypeDouble:
+            return static_cast<std::int16_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeString:
+            try 
+            { 
+                return static_cast<std::int16_t>(std::stoi(std::get<StringData>(m_value).GetString())); 
+            } 
+            catch (...) 
+            { 
+                break; 
+            }
+        case TypeByteVector:
+            return DataToInt16(std::get<Bytes>(m_value), pOk);
+        default:
+            break;
+    }
+
+    // Conversion not possible or not yet implemented!
+    if (pOk != nullptr) *pOk = false;
+
+    return std::int16_t(0);
+}
+
 std::int32_t Variant::ToInt32(bool* pOk) const
 {
     if (pOk != nullptr) *pOk = true;
@@ -202,8 +382,14 @@ std::int32_t Variant::ToInt32(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? 1 : 0;
+        case TypeInt8:
+            return static_cast<std::int32_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::int32_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return std::get<std::int32_t>(m_value);
+        case TypeInt64:
+            return static_cast<std::int32_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::int32_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -219,14 +405,14 @@ std::int32_t Variant::ToInt32(bool* pOk) const
         case TypeString:
             try 
             { 
-                return std::stol(std::get<std::string>(m_value)); 
+                return std::stol(std::get<StringData>(m_value).GetString()); 
             } 
             catch (...) 
             { 
                 break; 
             }
         case TypeByteVector:
-            return DataToInt32(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToInt32(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -237,6 +423,55 @@ std::int32_t Variant::ToInt32(bool* pOk) const
     return std::int32_t(0);
 }
 
+std::int64_t Variant::ToInt64(bool* pOk) const
+{
+    if (pOk != nullptr) *pOk = true;
+
+    switch (m_value.index())
+    {
+        case TypeBool:
+            return std::get<bool>(m_value) ? std::int64_t(1) : std::int64_t(0);
+        case TypeInt8:
+            return static_cast<std::int64_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::int64_t>(std::get<std::int16_t>(m_value));
+        case TypeInt32:
+            return static_cast<std::int64_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return std::get<std::int64_t>(m_value);
+        case TypeUInt8:
+            return static_cast<std::int64_t>(std::get<std::uint8_t>(m_value));
+        case TypeUInt16:
+            return static_cast<std::int64_t>(std::get<std::uint16_t>(m_value));
+        case TypeUInt32:
+            return static_cast<std::int64_t>(std::get<std::uint32_t>(m_value));
+        case TypeUInt64:
+            return static_cast<std::int64_t>(std::get<std::uint64_t>(m_value));
+        case TypeFloat:
+            return std::llround(std::get<std::float_t>(m_value));
+        case TypeDouble:
+            return std::llround(std::get<std::double_t>(m_value));
+        case TypeString:
+            try 
+            { 
+                return std::stoll(std::get<StringData>(m_value).GetString()); 
+            } 
+            catch (...) 
+            { 
+                break; 
+            }
+        case TypeByteVector:
+            return DataToInt64(std::get<Bytes>(m_value), pOk);
+        default:
+            break;
+    }
+
+    // Conversion not possible or not yet implemented!
+    if (pOk != nullptr) *pOk = false;
+
+    return std::int64_t(0);
+}
+
 std::uint8_t Variant::ToUInt8(bool* pOk) const
 {
     if (pOk != nullptr) *pOk = true;
@@ -245,8 +480,14 @@ std::uint8_t Variant::ToUInt8(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::uint8_t(1) : std::uint8_t(0);
+        case TypeInt8:
+            return static_cast<std::uint8_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint8_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::uint8_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint8_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return std::get<std::uint8_t>(m_value);
         case TypeUInt16:
@@ -262,14 +503,14 @@ std::uint8_t Variant::ToUInt8(bool* pOk) const
         case TypeString:
             try
             {
-                return static_cast<std::uint8_t>(std::stol(std::get<std::string>(m_value)));
+                return static_cast<std::uint8_t>(std::stol(std::get<StringData>(m_value).GetString()));
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToUint8(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToUint8(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -288,8 +529,14 @@ std::uint16_t Variant::ToUInt16(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::uint16_t(1) : std::uint16_t(0);
+        case TypeInt8:
+            return static_cast<std::uint16_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint16_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::uint16_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint16_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::uint16_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -305,14 +552,14 @@ std::uint16_t Variant::ToUInt16(bool* pOk) const
         case TypeString:
             try
             {
-                return static_cast<std::uint16_t>(std::stoi(std::get<std::string>(m_value)));
+                return static_cast<std::uint16_t>(std::stoi(std::get<StringData>(m_value).GetString()));
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToUint16(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToUint16(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -331,8 +578,14 @@ std::uint32_t Variant::ToUInt32(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::uint32_t(1) : std::uint32_t(0);
+        case TypeInt8:
+            return static_cast<std::uint32_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint32_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::uint32_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint32_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::uint32_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -348,14 +601,14 @@ std::uint32_t Variant::ToUInt32(bool* pOk) const
         case TypeString:
             try
             {
-                return static_cast<std::uint32_t>(std::stoi(std::get<std::string>(m_value)));
+                return static_cast<std::uint32_t>(std::stoi(std::get<StringData>(m_value).GetString()));
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToUint32(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToUint32(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -374,8 +627,14 @@ std::uint64_t Variant::ToUInt64(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::uint64_t(1) : std::uint64_t(0);
+        case TypeInt8:
+            return static_cast<std::uint64_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint64_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::uint64_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint64_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::uint64_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -391,14 +650,14 @@ std::uint64_t Variant::ToUInt64(bool* pOk) const
         case TypeString:
             try
             {
-                return static_cast<std::uint64_t>(std::stoll(std::get<std::string>(m_value)));
+                return static_cast<std::uint64_t>(std::stoll(std::get<StringData>(m_value).GetString()));
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToUint64(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToUint64(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -417,8 +676,14 @@ std::double_t Variant::ToDouble(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::double_t(1.0) : std::double_t(0.0);
+        case TypeInt8:
+            return static_cast<std::double_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::double_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::double_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::double_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::double_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -434,14 +699,14 @@ std::double_t Variant::ToDouble(bool* pOk) const
         case TypeString:
             try
             {
-                return std::stod(std::get<std::string>(m_value));
+                return std::stod(std::get<StringData>(m_value).GetString());
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToDouble(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToDouble(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -460,8 +725,14 @@ std::float_t Variant::ToFloat(bool* pOk) const
     {
         case TypeBool:
             return std::get<bool>(m_value) ? std::float_t(1.0f) : std::float_t(0.0f);
+        case TypeInt8:
+            return static_cast<std::float_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::float_t>(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return static_cast<std::float_t>(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::float_t>(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return static_cast<std::float_t>(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -477,14 +748,14 @@ std::float_t Variant::ToFloat(bool* pOk) const
         case TypeString:
             try
             {
-                return static_cast<std::float_t>(std::stof(std::get<std::string>(m_value)));
+                return static_cast<std::float_t>(std::stof(std::get<StringData>(m_value).GetString()));
             }
             catch (...)
             {
                 break;
             }
         case TypeByteVector:
-            return DataToFloat(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToFloat(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -503,8 +774,14 @@ std::string Variant::ToString(bool* pOk) const
     {
         case TypeBool:
             return (std::get<bool>(m_value) ? "true" : "false");
+        case TypeInt8:
+            return std::to_string(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return std::to_string(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return std::to_string(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return std::to_string(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return std::to_string(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -518,9 +795,9 @@ std::string Variant::ToString(bool* pOk) const
         case TypeDouble:
             return std::to_string(std::get<std::double_t>(m_value));
         case TypeString:
-            return std::get<std::string>(m_value);
+            return std::get<StringData>(m_value).GetString();
         case TypeByteVector:
-            return DataToString(std::get<std::vector<std::uint8_t>>(m_value), pOk);
+            return DataToString(std::get<Bytes>(m_value), pOk);
         default:
             break;
     }
@@ -531,6 +808,31 @@ std::string Variant::ToString(bool* pOk) const
     return std::string{};
 }
 
+std::string_view Variant::ToStringView(bool* pOk) const
+{
+    std::string_view ret;
+    bool ok = true;
+
+    if (m_value.index() == TypeString)
+    {
+        ret = std::get<StringData>(m_value).GetView();
+    }
+    else if (m_value.index() == TypeByteVector && std::get<Bytes>(m_value).size() >= 2) // Like DataToString, skip the length.
+    {
+        const auto& data = std::get<Bytes>(m_value);
+        ret = std::string_view(reinterpret_cast<const char*>(data.data()) + 2, data.size() - 2);
+    }
+    else
+    {
+        ok = false;
+    }
+
+    if (pOk != nullptr)
+        *pOk = ok;
+
+    return ret;
+}
+
 std::vector<std::uint8_t> Variant::ToByteVector(bool* pOk) const
 {
     if (pOk != nullptr) *pOk = true;
@@ -539,8 +841,14 @@ std::vector<std::uint8_t> Variant::ToByteVector(bool* pOk) const
     {
         case TypeBool:
             return DataFromBool(std::get<bool>(m_value));
+        case TypeInt8:
+            return DataFromInt8(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return DataFromInt16(std::get<std::int16_t>(m_value));
         case TypeInt32:
             return DataFromInt32(std::get<std::int32_t>(m_value));
+        case TypeInt64:
+            return DataFromInt64(std::get<std::int64_t>(m_value));
         case TypeUInt8:
             return DataFromUint8(std::get<std::uint8_t>(m_value));
         case TypeUInt16:
@@ -554,9 +862,13 @@ std::vector<std::uint8_t> Variant::ToByteVector(bool* pOk) const
         case TypeDouble:
             return DataFromDouble(std::get<std::double_t>(m_value));
         case TypeString:
-            return DataFromString(std::get<std::string>(m_value));
+            return DataFromString(std::get<StringData>(m_value).GetString());
+        case TypeBitString:
+            return std::get<MarshaledData<OCP1DATATYPE_BIT_STRING>>(m_value).m_data.toVector();
         case TypeByteVector:
-            return std::get<std::vector<std::uint8_t>>(m_value);
+            return std::get<Bytes>(m_value).toVector();
+        case TypeBlobFixedLen:
+            return std::get<MarshaledData<OCP1DATATYPE_BLOB_FIXED_LEN>>(m_value).m_data.toVector();
         default:
             break;
     }
@@ -579,8 +891,14 @@ std::vector<std::uint8_t> Variant::ToParamData(Ocp1DataType type /* = OCP1DATATY
     {
         case OCP1DATATYPE_BOOLEAN:
             return DataFromBool(ToBool(pOk));
+        case OCP1DATATYPE_INT8:
+            return DataFromInt8(ToInt8(pOk));
+        case OCP1DATATYPE_INT16:
+            return DataFromInt16(ToInt16(pOk));
         case OCP1DATATYPE_INT32:
             return DataFromInt32(ToInt32(pOk));
+        case OCP1DATATYPE_INT64:
+            return DataFromInt64(ToInt64(pOk));
         case OCP1DATATYPE_UINT8:
             return DataFromUint8(ToUInt8(pOk));
         case OCP1DATATYPE_UINT16:
@@ -595,16 +913,21 @@ std::vector<std::uint8_t> Variant::ToParamData(Ocp1DataType type /* = OCP1DATATY
             return DataFromDouble(ToDouble(pOk));
         case OCP1DATATYPE_STRING:
             return DataFromString(ToString(pOk));
+        case OCP1DATATYPE_BIT_STRING:
+            {
+                auto bits = ToBitString(pOk);
+                return DataFrom(bits);
+            }
         case OCP1DATATYPE_BLOB:
             return ToByteVector(pOk);
+        case OCP1DATATYPE_BLOB_FIXED_LEN:
+            {
+                auto blob = ToBlobFixedLen(pOk);
+                return std::vector<std::uint8_t>(blob.begin(), blob.end());
+            }
         case OCP1DATATYPE_DB_POSITION:
             return ToByteVector(pOk);
         case OCP1DATATYPE_NONE:
-        case OCP1DATATYPE_INT8:
-        case OCP1DATATYPE_INT16:
-        case OCP1DATATYPE_INT64:
-        case OCP1DATATYPE_BIT_STRING:
-        case OCP1DATATYPE_BLOB_FIXED_LEN:
         case OCP1DATATYPE_CUSTOM:
         default:
             break;
@@ -618,28 +941,21 @@ std::vector<std::uint8_t> Variant::ToParamData(Ocp1DataType type /* = OCP1DATATY
 
 std::array<std::float_t, 3> Variant::ToPosition(bool* pOk) const
 {
-    std::array<std::float_t, 3> ret{ 0.0f };
-
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
-
-        return ret;
-    }
-
-    const auto& data = std::get<std::vector<std::uint8_t>>(m_value);
-    bool ok = ((data.size() == 12) || // Value contains 3 floats: x, y, z.
-               (data.size() == 36));  // Value contains 9 floats: x, y, z, plus min and max each on top.
+    auto pos = ToOcp1Position(pOk);
+    return { pos.m_x, pos.m_y, pos.m_z };
+}
 
-    if (ok)
-        ret[0] = NanoOcp1::DataToFloat(data, &ok); // x
+Ocp1Position Variant::ToOcp1Position(bool* pOk) const
+{
+    Ocp1Position ret{};
 
-    if (ok)
-        ret[1] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 4, data.data() + 8), &ok); // y
+    const auto* data = std::get_if<Bytes>(&m_value);
+    bool ok = (data != nullptr) &&
+              ((data->size() == 12) || // Value contains 3 floats: x, y, z.
+               (data->size() == 36));  // Value contains 9 floats: x, y, z, plus min and max each on top.
 
     if (ok)
-        ret[2] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 8, data.data() + 12), &ok); // z
+        NanoOcp1::Ocp1Codec<Ocp1Position>::Decode(*data, ret);
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -654,12 +970,7 @@ std::string Variant::ToPositionString(bool* pOk) const
 
     auto pos = ToPosition(&ok);
     if (ok)
-    {
-        std::stringstream ss;
-        ss << pos[0] << ", " << pos[1] << ", " << pos[2];
-
-        ret = std::string(ss.str());
-    }
+        ret = ToCommaSeparatedString(pos);
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -674,36 +985,19 @@ std::array<std::float_t, 6> Variant::ToPositionAndRotation(bool* pOk) const
 
 std::array<std::float_t, 6> Variant::ToAimingAndPosition(bool* pOk) const
 {
-    std::array<std::float_t, 6> ret{ 0.0f };
-
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
-
-        return ret;
-    }
-
-    const auto& data = std::get<std::vector<std::uint8_t>>(m_value);
-    bool ok = (data.size() == 24); // Value contains 6 floats: horAngle, vertAngle, rotAngle, x, y, z.
-    
-    if (ok)
-        ret[0] = NanoOcp1::DataToFloat(data, &ok); // hor
-
-    if (ok)
-        ret[1] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 4, data.data() + 8), &ok); // ver
-
-    if (ok)
-        ret[2] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 8, data.data() + 12), &ok); // rot
+    auto aimingAndPos = ToOcp1AimingAndPosition(pOk);
+    return { aimingAndPos.m_hor, aimingAndPos.m_vert, aimingAndPos.m_rot, aimingAndPos.m_x, aimingAndPos.m_y, aimingAndPos.m_z };
+}
 
-    if (ok)
-        ret[3] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 12, data.data() + 16), &ok); // x
+Ocp1AimingAndPosition Variant::ToOcp1AimingAndPosition(bool* pOk) const
+{
+    Ocp1AimingAndPosition ret{};
 
-    if (ok)
-        ret[4] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 16, data.data() + 20), &ok); // y
+    const auto* data = std::get_if<Bytes>(&m_value);
+    bool ok = (data != nullptr) && (data->size() == 24); // Value contains 6 floats: horAngle, vertAngle, rotAngle, x, y, z.
 
     if (ok)
-        ret[5] = NanoOcp1::DataToFloat(std::vector<std::uint8_t>(data.data() + 20, data.data() + 24), &ok); // z
+        NanoOcp1::Ocp1Codec<Ocp1AimingAndPosition>::Decode(*data, ret);
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -718,13 +1012,7 @@ std::string Variant::ToAimingAndPositionString(bool* pOk) const
 
     auto pos = ToAimingAndPosition(&ok);
     if (ok)
-    {
-        std::stringstream ss;
-        ss << pos[0] << ", " << pos[1] << ", " << pos[2] << ", " <<
-              pos[3] << ", " << pos[4] << ", " << pos[5];
-
-        ret = std::string(ss.str());
-    }
+        ret = ToCommaSeparatedString(pos);
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -734,90 +1022,45 @@ std::string Variant::ToAimingAndPositionString(bool* pOk) const
 
 std::vector<bool> Variant::ToBoolVector(bool* pOk) const
 {
-    std::vector<bool> boolVector;
-
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
-
-        return boolVector;
-    }
+    return ToListView<bool>(pOk).toVector();
+}
 
-    const auto& data = std::get<std::vector<std::uint8_t>>(m_value);
-    bool ok = (data.size() >= 2); // OcaList size takes up the first 2 bytes.
+std::vector<std::string> Variant::ToStringVector(bool* pOk) const
+{
+    return ToListView<std::string>(pOk).toVector();
+}
 
-    std::uint16_t listSize(0);
-    if (ok)
-        listSize = NanoOcp1::DataToUint16(data, &ok);
+Ocp1BitStringView Variant::ToBitString(bool* pOk) const
+{
+    Ocp1BitStringView ret;
 
-    ok = ok && (data.size() == listSize + 2);
-    if (ok && listSize > 0)
-    {
-        boolVector.reserve(listSize);
-        std::size_t readPos(2); // Start after the OcaList size bytes
-        while (readPos < data.size() && ok)
-        {
-            std::vector<std::uint8_t> tmpData(data.data() + readPos, data.data() + readPos + 1);
-            boolVector.push_back(NanoOcp1::DataToBool(tmpData, &ok));
-            readPos++;
-        }
-    }
+    const Bytes* data = nullptr;
+    if (m_value.index() == TypeBitString)
+        data = &std::get<MarshaledData<OCP1DATATYPE_BIT_STRING>>(m_value).m_data;
+    else if (m_value.index() == TypeByteVector)
+        data = &std::get<Bytes>(m_value);
 
-    ok = ok && (boolVector.size() == listSize);
+    bool ok = (data != nullptr) && (NanoOcp1::Ocp1Codec<Ocp1BitStringView>::Decode(*data, ret) > 0);
 
     if (pOk != nullptr)
         *pOk = ok;
 
-    return boolVector;
+    return ret;
 }
 
-std::vector<std::string> Variant::ToStringVector(bool* pOk) const
+std::span<const std::uint8_t> Variant::ToBlobFixedLen(bool* pOk) const
 {
-    std::vector<std::string> stringVector;
-
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
-
-        return stringVector;
-    }
+    std::span<const std::uint8_t> ret;
 
-    const auto& data = std::get<std::vector<std::uint8_t>>(m_value);
-    bool ok = (data.size() >= 2); // OcaList size takes up the first 2 bytes.
-
-    std::uint16_t listSize(0);
-    if (ok)
-        listSize = NanoOcp1::DataToUint16(data, &ok);
-
-    // Byte vector has the right size even assuming empty strings (min 2 bytes per string + 2 bytes for list size).
-    ok = ok && (data.size() >= ((listSize * 2) + 2));
-    if (ok && listSize > 0)
-    {
-        stringVector.reserve(static_cast<size_t>(listSize));
-        std::size_t readPos(2); // Start after the OcaList size bytes
-        while (readPos + 2 <= data.size() && ok)
-        {
-            std::vector<std::uint8_t> stringLenData(data.data() + readPos, data.data() + readPos + 2);
-            auto stringLen = NanoOcp1::DataToUint16(stringLenData, &ok);
-            readPos += 2;
-
-            ok = ok && (readPos + stringLen <= data.size());
-            if (ok)
-            {
-                stringVector.push_back(std::string(data.data() + readPos, data.data() + readPos + stringLen));
-                readPos += stringLen;
-            }
-        }
-    }
-
-    ok = ok && (stringVector.size() == listSize);
+    if (m_value.index() == TypeBlobFixedLen)
+        ret = std::get<MarshaledData<OCP1DATATYPE_BLOB_FIXED_LEN>>(m_value).m_data;
+    else if (m_value.index() == TypeByteVector)
+        ret = std::get<Bytes>(m_value);
 
     if (pOk != nullptr)
-        *pOk = ok;
+        *pOk = !ret.empty();
 
-    return stringVector;
+    return ret;
 }
 
 }
@@ -19,9 +19,14 @@
 #pragma once
 
 #include <cstdint>          //< USE std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t in GCC-13
-#include <variant>          //< USE std::variant
+#include <type_traits>      //< USE std::is_arithmetic_v
+#include <variant>          //< USE std::variant, std::visit
 #include <array>            //< USE std::array
+#include <span>             //< USE std::span
+#include <string_view>      //< USE std::string_view
 #include "Ocp1DataTypes.h"  //< USE NanoOcp1::Ocp1DataType
+#include "Ocp1ListView.h"   //< USE NanoOcp1::Ocp1ListView, NanoOcp1::Ocp1MapView
+#include "Ocp1SmallByteVector.h"    //< USE NanoOcp1::Ocp1SmallByteVector
 
 
 namespace NanoOcp1
@@ -35,12 +40,17 @@ namespace NanoOcp1
  *    Note that these type conversions are mostly only supported between primitive types.
  *  - Marshaling: A Variant can be directly created (unmarshaled) from a byte vector,
  *    and it can also be marshaled into its byte-vector representation using the ToParamData method.
+ *  - Storage: strings, positions and other marshaled data of up to InlineCapacity bytes are kept
+ *    inside the Variant, so creating, copying and moving such Variants does not allocate.
  */
 class Variant
 {
 public:
     Variant(bool v);
+    Variant(std::int8_t v);
+    Variant(std::int16_t v);
     Variant(std::int32_t v);
+    Variant(std::int64_t v);
     Variant(std::uint8_t v);
     Variant(std::uint16_t v);
     Variant(std::uint32_t v);
@@ -48,8 +58,12 @@ public:
     Variant(std::float_t v);
     Variant(std::double_t v);
     Variant(const std::string& v);
+    Variant(std::string_view v);
     Variant(const char* v);
     Variant(std::float_t x, std::float_t y, std::float_t z);
+    Variant(const Ocp1Position& v);
+    Variant(const Ocp1AimingAndPosition& v);
+    Variant(const Ocp1BitStringView& v);
 
     /**
      * Default constructor. Type-less and value-less per default, and will return FALSE on IsValid as such.
@@ -65,6 +79,26 @@ public:
      */
     Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type = OCP1DATATYPE_BLOB);
 
+    /**
+     * Unmarshaling constructor, which takes over the data's buffer if it is too large to be stored inline.
+     *
+     * @param[in] data  Byte vector representing the parameter data obtained by i.e. an OCP1 Notification or Response.
+     * @param[in] type  Data type of the Ocp1CommandDefinition associated with that OCP1 message.
+     */
+    Variant(std::vector<std::uint8_t>&& data, Ocp1DataType type = OCP1DATATYPE_BLOB);
+
+    /**
+     * Unmarshaling constructor for data that is not held in a byte vector.
+     *
+     * @param[in] data  Parameter data obtained by i.e. an OCP1 Notification or Response.
+     * @param[in] type  Data type of the Ocp1CommandDefinition associated with that OCP1 message.
+     */
+    Variant(std::span<const std::uint8_t> data, Ocp1DataType type);
+
+    Variant(const Variant&) = default;
+    Variant(Variant&&) noexcept = default;
+    Variant& operator=(const Variant&) = default;
+    Variant& operator=(Variant&&) noexcept = default;
     virtual ~Variant() = default;
     bool operator==(const Variant& other) const;
     bool operator!=(const Variant& other) const;
@@ -99,7 +133,10 @@ public:
      */
 
     bool ToBool(bool* pOk = nullptr) const;
+    std::int8_t ToInt8(bool* pOk = nullptr) const;
+    std::int16_t ToInt16(bool* pOk = nullptr) const;
     std::int32_t ToInt32(bool* pOk = nullptr) const;
+    std::int64_t ToInt64(bool* pOk = nullptr) const;
     std::uint8_t ToUInt8(bool* pOk = nullptr) const;
     std::uint16_t ToUInt16(bool* pOk = nullptr) const;
     std::uint32_t ToUInt32(bool* pOk = nullptr) const;
@@ -108,6 +145,58 @@ public:
     std::double_t ToDouble(bool* pOk = nullptr) const;
     std::string ToString(bool* pOk = nullptr) const;
 
+    /**
+     * Fast access to a Variant's value without any conversion, e.g.
+     *
+     *     if (const auto* gain = variant.TryGet<std::float_t>())
+     *         ...
+     *
+     * @return  Pointer to the stored value if the Variant holds exactly type T, nullptr otherwise.
+     */
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    const T* TryGet() const noexcept
+    {
+        return std::get_if<T>(&m_value);
+    }
+
+    /**
+     * Invokes the visitor with the stored value, without any conversion:
+     * std::monostate if the Variant is not valid, bool, integers and floats by reference,
+     * std::string_view for strings, Ocp1BitStringView for bit strings and
+     * std::span<const std::uint8_t> for all other marshaled data (blobs and positions).
+     *
+     * @param[in] visitor   Callable accepting all of the above, e.g. a generic lambda.
+     * @return  Whatever the visitor returns.
+     */
+    template <typename Visitor>
+    decltype(auto) Visit(Visitor&& visitor) const
+    {
+        return std::visit([&](const auto& value) -> decltype(auto)
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, StringData>)
+                return visitor(value.GetView());
+            else if constexpr (std::is_same_v<T, MarshaledData<OCP1DATATYPE_BIT_STRING>>)
+                return visitor(ToBitString());
+            else if constexpr (std::is_same_v<T, MarshaledData<OCP1DATATYPE_BLOB_FIXED_LEN>>)
+                return visitor(std::span<const std::uint8_t>(value.m_data));
+            else if constexpr (std::is_same_v<T, Bytes>)
+                return visitor(std::span<const std::uint8_t>(value));
+            else
+                return visitor(value);
+        }, m_value);
+    }
+
+    /**
+     * Access to the characters of a Variant of TypeString without copying them.
+     * @note The returned view points into this Variant and is only valid as long as it is not modified or destroyed.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  The characters, empty if the Variant is neither a string nor a marshaled OcaString.
+     */
+    std::string_view ToStringView(bool* pOk = nullptr) const;
+
     /**
      * Convenience helper method to extract x, y, and z float values from a Variant.
      * The Variant should internally contain the values as 3 x 4 bytes.
@@ -117,6 +206,14 @@ public:
      */
     std::array<std::float_t, 3> ToPosition(bool* pOk = nullptr) const;
 
+    /**
+     * Same as ToPosition, but with named members.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  The contained position.
+     */
+    Ocp1Position ToOcp1Position(bool* pOk = nullptr) const;
+
     /**
      * Calls ToPosition and returns a human-readable string with the result.
      *
@@ -136,6 +233,14 @@ public:
      */
     std::array<std::float_t, 6> ToAimingAndPosition(bool* pOk = nullptr) const;
 
+    /**
+     * Same as ToAimingAndPosition, but with named members.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  The contained aiming angles and position.
+     */
+    Ocp1AimingAndPosition ToOcp1AimingAndPosition(bool* pOk = nullptr) const;
+
     [[deprecated("Use ToAimingAndPosition instead, this method will be removed in the future. "
       "NOTE: The output of both methods is identical, but the new method has a more consistent name.")]]
     std::array<std::float_t, 6> ToPositionAndRotation(bool* pOk = nullptr) const;
@@ -167,6 +272,52 @@ public:
      */
     std::vector<std::string> ToStringVector(bool* pOk = nullptr) const;
 
+    /**
+     * Convenience helper method to access the bits of an OcaBitString without unpacking them.
+     * The Variant's contents need to be marshalled as an OcaBitString.
+     * @note The returned view points into this Variant and is only valid as long as it is not modified or destroyed.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  A view of the packed bits.
+     */
+    Ocp1BitStringView ToBitString(bool* pOk = nullptr) const;
+
+    /**
+     * Convenience helper method to access the bytes of an OcaBlobFixedLen without copying them.
+     * @note The returned span points into this Variant and is only valid as long as it is not modified or destroyed.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  The blob's bytes.
+     */
+    std::span<const std::uint8_t> ToBlobFixedLen(bool* pOk = nullptr) const;
+
+    /**
+     * Convenience helper method to iterate an OcaList<T> without unpacking it,
+     * e.g. ToListView<std::string>() to iterate the names of a switch as std::string_views.
+     * @note The returned view points into this Variant and is only valid as long as it is not modified or destroyed.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  A view of the list, empty if the Variant's contents are not exactly one OcaList<T>.
+     */
+    template <typename T>
+    Ocp1ListView<T> ToListView(bool* pOk = nullptr) const
+    {
+        return ToView<Ocp1ListView<T>>(pOk);
+    }
+
+    /**
+     * Convenience helper method to iterate an OcaMap<K, V> without unpacking it.
+     * @note The returned view points into this Variant and is only valid as long as it is not modified or destroyed.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  A view of the map, empty if the Variant's contents are not exactly one OcaMap<K, V>.
+     */
+    template <typename K, typename V>
+    Ocp1MapView<K, V> ToMapView(bool* pOk = nullptr) const
+    {
+        return ToView<Ocp1MapView<K, V>>(pOk);
+    }
+
 
 protected:
     /**
@@ -177,6 +328,35 @@ protected:
      */
     std::vector<std::uint8_t> ToByteVector(bool* pOk = nullptr) const;
 
+    /**
+     * Checks the size of data to be stored as TypeByteVector, i.e. of an OcaBlob or a position.
+     */
+    static bool IsValidByteVector(std::span<const std::uint8_t> data, Ocp1DataType type);
+
+    /**
+     * Creates a view of type View (Ocp1ListView or Ocp1MapView) of the Variant's byte vector,
+     * which needs to be occupied by the viewed data exactly.
+     */
+    template <typename View>
+    View ToView(bool* pOk) const
+    {
+        View ret;
+
+        bool ok = false;
+        if (const auto* data = std::get_if<Bytes>(&m_value))
+        {
+            ret = View(std::span<const std::uint8_t>(*data), &ok);
+            ok = ok && (ret.getByteSize() == data->size());
+            if (!ok)
+                ret = View();
+        }
+
+        if (pOk != nullptr)
+            *pOk = ok;
+
+        return ret;
+    }
+
     /**
      * Used internally to identify the possible types that the internal std::variant can assume.
      * Mirrors enum Ocp1DataType, but without gaps (essential for std::variant) or unused types.
@@ -185,7 +365,10 @@ protected:
     {
         TypeNone = 0,
         TypeBool,
+        TypeInt8,
+        TypeInt16,
         TypeInt32,
+        TypeInt64,
         TypeUInt8,
         TypeUInt16,
         TypeUInt32,
@@ -193,24 +376,67 @@ protected:
         TypeFloat,
         TypeDouble,
         TypeString,
-        TypeByteVector
+        TypeBitString,
+        TypeByteVector,
+        TypeBlobFixedLen
+    };
+
+    /**
+     * Number of bytes stored inside the Variant before it resorts to the heap.
+     * Large enough for a position with its min and max values (9 floats).
+     */
+    static constexpr std::size_t InlineCapacity = 40;
+
+    /**
+     * Storage of all byte-based alternatives.
+     */
+    using Bytes = Ocp1SmallByteVector<InlineCapacity>;
+
+    /**
+     * Characters of a TypeString, without OcaString length.
+     */
+    struct StringData
+    {
+        Bytes m_chars;
+
+        std::string_view GetView() const { return std::string_view(reinterpret_cast<const char*>(m_chars.data()), m_chars.size()); }
+        std::string GetString() const { return std::string(GetView()); }
+
+        bool operator==(const StringData&) const = default;
+    };
+
+    /**
+     * Marshaled bytes of a type that is accessed through a view rather than unpacked,
+     * tagged with the type to be distinguishable from TypeByteVector.
+     */
+    template <Ocp1DataType DataType>
+    struct MarshaledData
+    {
+        Bytes m_data;
+
+        bool operator==(const MarshaledData&) const = default;
     };
 
     /**
      * Definition of the internal std::variant class template.
      * The internal m_value holds a value of exactly one of the alternative types at any given time.
      */
-    using VariantType = std::variant<std::monostate,                // TypeNone
-                                     bool,                          // TypeBool
-                                     std::int32_t,                  // TypeInt32
-                                     std::uint8_t,                  // TypeUInt8
-                                     std::uint16_t,                 // TypeUInt16
-                                     std::uint32_t,                 // TypeUInt32
-                                     std::uint64_t,                 // TypeUInt64
-                                     std::float_t,                  // TypeFloat
-                                     std::double_t,                 // TypeDouble
-                                     std::string,                   // TypeString
-                                     std::vector<std::uint8_t>>;    // TypeByteVector
+    using VariantType = std::variant<std::monostate,                                    // TypeNone
+                                     bool,                                              // TypeBool
+                                     std::int8_t,                                       // TypeInt8
+                                     std::int16_t,                                      // TypeInt16
+                                     std::int32_t,                                      // TypeInt32
+                                     std::int64_t,                                      // TypeInt64
+                                     std::uint8_t,                                      // TypeUInt8
+                                     std::uint16_t,                                     // TypeUInt16
+                                     std::uint32_t,                                     // TypeUInt32
+                                     std::uint64_t,                                     // TypeUInt64
+                                     std::float_t,                                      // TypeFloat
+                                     std::double_t,                                     // TypeDouble
+                                     StringData,                                        // TypeString
+                                     MarshaledData<OCP1DATATYPE_BIT_STRING>,            // TypeBitString: count and packed bits.
+                                     Bytes,                                             // TypeByteVector
+                                     MarshaledData<OCP1DATATYPE_BLOB_FIXED_LEN>>;       // TypeBlobFixedLen: the bytes only.
 
 private:
     /**